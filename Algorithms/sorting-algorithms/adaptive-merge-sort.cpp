@@ -0,0 +1,347 @@
+/*
+    Adaptive Merge Sort (Powersort):
+    - A natural merge sort that takes advantage of the order already present in the input,
+      in the style of Timsort and of Python's list.sort.
+    - The array is scanned from left to right for runs: maximal non-descending sequences, or
+      strictly descending ones, which are reversed in place (strictness keeps this stable).
+    - Runs shorter than minrun (between 32 and 64, chosen from n) are extended to minrun
+      elements with binary insertion sort.
+    - The order of the merges follows the powersort policy (Munro & Wild): the boundary
+      between two runs gets a "power", the depth of their midpoints' split in a perfectly
+      balanced merge tree over [0, n). Runs are kept on a stack, and when a boundary of
+      lower power arrives every pending boundary of higher power is merged first. The merge
+      cost is then within n log n of the optimum for the given runs.
+    - Merges first skip the prefix of the left run and the suffix of the right run that are
+      already in place, then move the shorter run to a buffer and merge from that side.
+      When one run keeps winning, the merge gallops: it finds how many elements to take at
+      once with an exponential search, so interleaving runs of very different lengths
+      costs O(log) comparisons per block instead of one per element.
+
+    Time Complexity:
+    - Best Case: O(n) - When the array is already sorted, or sorted in reverse.
+    - Average Case: O(n log n) - O(n + n H) where H is the entropy of the run lengths.
+    - Worst Case: O(n log n)
+
+    Space Complexity: O(n) - A buffer of at most n / 2 elements, and O(log n) pending runs.
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm> // For std::partition_point, std::reverse, std::upper_bound
+#include <cstdint>
+#include <iterator>  // For std::iter_value_t, std::make_move_iterator
+#include <utility>   // For std::move
+
+#include "helper/SortInterface.cpp"
+
+// Consecutive wins of one run after which a merge starts galloping (adapted during a sort)
+constexpr size_t MIN_GALLOP = 7;
+
+// Template function to find the first element of [first, last) for which `before` is false,
+// where `before` holds on a prefix, probing positions 0, 1, 3, 7, ... from the front
+template <typename RandomIt, typename Pred>
+RandomIt gallopFront(RandomIt first, RandomIt last, Pred before) {
+    size_t n = last - first;
+    size_t lo = 0, probe = 0;
+    while (probe < n && before(first[probe])) {
+        lo = probe + 1;
+        probe = 2 * probe + 1;
+    }
+    return std::partition_point(first + lo, first + std::min(probe, n), before);
+}
+
+// Template function to find the first element of [first, last) for which `before` is false,
+// where `before` holds on a prefix, probing positions n - 1, n - 2, n - 4, ... from the back
+template <typename RandomIt, typename Pred>
+RandomIt gallopBack(RandomIt first, RandomIt last, Pred before) {
+    size_t n = last - first;
+    size_t hi = n, step = 1;
+    while (step <= n && !before(first[n - step])) {
+        hi = n - step;
+        step *= 2;
+    }
+    size_t lo = step <= n ? n - step + 1 : 0;
+    return std::partition_point(first + lo, first + hi, before);
+}
+
+// Template function to return the minimum run length for n elements: n itself for small
+// arrays, otherwise a value in [32, 64] such that n / minrun is a power of 2 or just below
+inline size_t minRunLength(size_t n) {
+    size_t extra = 0; // Set if any bit shifted out is set
+    while (n >= 64) {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+// Template function to return the end of the run starting at first. A strictly descending
+// run is reversed, so the range [first, returned) is always non-descending.
+template <typename RandomIt, typename Less>
+RandomIt findRun(RandomIt first, RandomIt last, Less& less) {
+    RandomIt end = first + 1;
+    if (end == last) return end;
+
+    if (less(*end, *first)) {
+        // Strictly descending: equal elements would lose their order when reversed
+        while (++end != last && less(*end, *(end - 1)));
+        std::reverse(first, end);
+    }
+    else {
+        while (++end != last && !less(*end, *(end - 1)));
+    }
+    return end;
+}
+
+// Template function to extend the sorted range [first, sorted) to [first, last) with binary
+// insertion sort. Equal elements are inserted after the existing ones, keeping it stable.
+template <typename RandomIt, typename Less>
+void binaryInsertionSort(RandomIt first, RandomIt sorted, RandomIt last, Less& less) {
+    for (RandomIt i = sorted; i != last; ++i) {
+        auto key = std::move(*i);
+        RandomIt pos = std::upper_bound(first, i, key, less);
+        std::move_backward(pos, i, i + 1);
+        *pos = std::move(key);
+    }
+}
+
+// Template function to return the power of the boundary between the adjacent runs
+// [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) out of n elements: the first bit at which the
+// binary expansions of the midpoints of both runs (as fractions of n) differ
+inline int nodePower(size_t s1, size_t n1, size_t n2, size_t n) {
+    // Twice the midpoints, so that they stay integers
+    uint64_t a = 2 * static_cast<uint64_t>(s1) + n1;
+    uint64_t b = a + n1 + n2;
+    int power = 0;
+    while (true) {
+        power++;
+        if (a >= n) {
+            // Both next bits are 1
+            a -= n;
+            b -= n;
+        }
+        else if (b >= n) {
+            // The bits differ
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+// Template struct with the state shared by the merges of one sort
+template <typename T>
+struct MergeState {
+    std::vector<T> buffer; // Holds the shorter run of a merge
+    size_t minGallop = MIN_GALLOP;
+};
+
+// Template function to merge the adjacent sorted runs [first, mid) and [mid, last), where the
+// left one is not longer than the right one. The left run is moved to the buffer and the merge
+// goes from the front.
+template <typename RandomIt, typename T, typename Less>
+void mergeLow(RandomIt first, RandomIt mid, RandomIt last, MergeState<T>& state, Less& less) {
+    std::vector<T>& buffer = state.buffer;
+    buffer.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+    auto a = buffer.begin(), aEnd = buffer.end(); // Left run
+    RandomIt b = mid;                             // Right run, still in place
+    RandomIt out = first;                         // Never ahead of b
+
+    while (a != aEnd && b != last) {
+        // Take one element at a time until one run has won minGallop times in a row
+        size_t winsA = 0, winsB = 0;
+        while (a != aEnd && b != last && winsA < state.minGallop && winsB < state.minGallop) {
+            // Ties go to the left run, for stability
+            if (less(*b, *a)) {
+                *out++ = std::move(*b++);
+                winsB++;
+                winsA = 0;
+            }
+            else {
+                *out++ = std::move(*a++);
+                winsA++;
+                winsB = 0;
+            }
+        }
+
+        // Gallop while it pays off: take whole blocks found by exponential search
+        bool galloped = false;
+        bool galloping = winsA >= state.minGallop || winsB >= state.minGallop;
+        while (galloping && a != aEnd && b != last) {
+            galloped = true;
+            if (state.minGallop > 1) state.minGallop--;
+
+            // Elements of the left run not greater than *b go first
+            auto aStop = gallopFront(a, aEnd, [&](const T& x) { return !less(*b, x); });
+            winsA = aStop - a;
+            out = std::move(a, aStop, out);
+            a = aStop;
+            if (a == aEnd) break;
+            *out++ = std::move(*b++);
+            if (b == last) break;
+
+            // Elements of the right run less than *a go next
+            RandomIt bStop = gallopFront(b, last, [&](const T& y) { return less(y, *a); });
+            winsB = bStop - b;
+            out = std::move(b, bStop, out);
+            b = bStop;
+            if (b == last) break;
+            *out++ = std::move(*a++);
+            galloping = winsA >= MIN_GALLOP || winsB >= MIN_GALLOP;
+        }
+        // Leaving the galloping mode makes it harder to enter it again
+        if (galloped) state.minGallop += 2;
+    }
+
+    // The rest of the right run is already in place
+    std::move(a, aEnd, out);
+}
+
+// Template function to merge the adjacent sorted runs [first, mid) and [mid, last), where the
+// right one is not longer than the left one. The right run is moved to the buffer and the
+// merge goes from the back.
+template <typename RandomIt, typename T, typename Less>
+void mergeHigh(RandomIt first, RandomIt mid, RandomIt last, MergeState<T>& state, Less& less) {
+    std::vector<T>& buffer = state.buffer;
+    buffer.assign(std::make_move_iterator(mid), std::make_move_iterator(last));
+    auto bFirst = buffer.begin(), b = buffer.end(); // Right run, consumed from the back
+    RandomIt a = mid;                               // Left run, still in place, consumed from the back
+    RandomIt out = last;                            // Never behind a
+
+    while (a != first && b != bFirst) {
+        // Take one element at a time until one run has won minGallop times in a row
+        size_t winsA = 0, winsB = 0;
+        while (a != first && b != bFirst && winsA < state.minGallop && winsB < state.minGallop) {
+            // The left element goes last only if it is strictly greater, for stability
+            if (less(*(b - 1), *(a - 1))) {
+                *--out = std::move(*--a);
+                winsA++;
+                winsB = 0;
+            }
+            else {
+                *--out = std::move(*--b);
+                winsB++;
+                winsA = 0;
+            }
+        }
+
+        // Gallop while it pays off: take whole blocks found by exponential search
+        bool galloped = false;
+        bool galloping = winsA >= state.minGallop || winsB >= state.minGallop;
+        while (galloping && a != first && b != bFirst) {
+            galloped = true;
+            if (state.minGallop > 1) state.minGallop--;
+
+            // Elements of the left run greater than the last of the right run go last
+            RandomIt aStop = gallopBack(first, a, [&](const T& x) { return !less(*(b - 1), x); });
+            winsA = a - aStop;
+            out = std::move_backward(aStop, a, out);
+            a = aStop;
+            if (a == first) break;
+            *--out = std::move(*--b);
+            if (b == bFirst) break;
+
+            // Elements of the right run not less than the last of the left run come before them
+            auto bStop = gallopBack(bFirst, b, [&](const T& y) { return less(y, *(a - 1)); });
+            winsB = b - bStop;
+            out = std::move_backward(bStop, b, out);
+            b = bStop;
+            if (b == bFirst) break;
+            *--out = std::move(*--a);
+            galloping = winsA >= MIN_GALLOP || winsB >= MIN_GALLOP;
+        }
+        // Leaving the galloping mode makes it harder to enter it again
+        if (galloped) state.minGallop += 2;
+    }
+
+    // The rest of the left run is already in place
+    std::move_backward(bFirst, b, out);
+}
+
+// Template function to merge the adjacent sorted runs [first, mid) and [mid, last)
+template <typename RandomIt, typename T, typename Less>
+void mergeRuns(RandomIt first, RandomIt mid, RandomIt last, MergeState<T>& state, Less& less) {
+    // Elements of the left run not greater than the first of the right run are in place
+    first = gallopFront(first, mid, [&](const auto& x) { return !less(*mid, x); });
+    if (first == mid) return;
+    // Elements of the right run not less than the last of the left run are in place
+    last = gallopBack(mid, last, [&](const auto& y) { return less(y, *(mid - 1)); });
+    if (mid == last) return;
+
+    if (mid - first <= last - mid) {
+        mergeLow(first, mid, last, state, less);
+    }
+    else {
+        mergeHigh(first, mid, last, state, less);
+    }
+}
+
+// Template function to perform Adaptive Merge Sort on [first, last) with a comparator on elements
+template <typename RandomIt, typename Less>
+void adaptiveMergeSortBy(RandomIt first, RandomIt last, Less& less) {
+    size_t n = last - first;
+    if (n < 2) return;
+    size_t minRun = minRunLength(n);
+
+    // Pending runs, each with the power of its boundary with the next run
+    struct Run {
+        size_t start, length;
+        int power;
+    };
+    std::vector<Run> runs;
+    MergeState<std::iter_value_t<RandomIt>> state;
+
+    // Function to merge the two runs on top of the stack
+    auto mergeTop = [&] {
+        Run right = runs.back();
+        runs.pop_back();
+        Run& left = runs.back();
+        mergeRuns(first + left.start, first + right.start, first + right.start + right.length, state, less);
+        left.length += right.length;
+        left.power = right.power;
+    };
+
+    for (size_t start = 0; start < n;) {
+        // Find the next run and extend it to minrun elements
+        size_t end = findRun(first + start, last, less) - first;
+        if (end - start < minRun) {
+            size_t extended = std::min(start + minRun, n);
+            binaryInsertionSort(first + start, first + end, first + extended, less);
+            end = extended;
+        }
+
+        // Merge the pending boundaries that are deeper in the merge tree than the new one
+        if (!runs.empty()) {
+            int power = nodePower(runs.back().start, runs.back().length, end - start, n);
+            while (runs.size() > 1 && runs[runs.size() - 2].power > power) {
+                mergeTop();
+            }
+            runs.back().power = power;
+        }
+        runs.push_back({ start, end - start, 0 });
+        start = end;
+    }
+
+    // Merge the remaining runs from right to left
+    while (runs.size() > 1) {
+        mergeTop();
+    }
+}
+
+// Template function to perform Adaptive Merge Sort
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void adaptiveMergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    adaptiveMergeSortBy(first, last, less);
+}
+
+// Template function to perform Adaptive Merge Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void adaptiveMergeSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    adaptiveMergeSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -1,113 +1,737 @@
+/*
+    Benchmark driver for the sorting algorithms.
+
+    Build: g++ -std=c++20 -O2 -pthread analyze.cpp -o analyze
+
+    Usage: analyze [options]
+      --sizes a,b,c          Array sizes to measure
+      --min N --max N        Size range, stepping by --step N (linear) or --factor F (geometric)
+      --dist a,b,...|all     Input distributions (random, sorted, reversed, few-unique,
+                             organ-pipe, sawtooth, zipf, nearly-sorted)
+      --swaps K              Swaps of the nearly-sorted distribution (default n / 100)
+      --reps N               Timed repetitions per cell (default 5)
+      --warmup N             Untimed runs per cell (default 1)
+      --seed N               Seed of the inputs (default 42)
+      --only a,b,...         Only run the named algorithms
+      --max-quadratic N      Largest size given to the O(n^2) sorts (default 32768)
+      --perf                 Also report hardware counters (cycles, instructions, L1/LLC
+                             misses, branch misses) if the PMU is accessible
+      --count                Count operations instead of timing: every algorithm sorts
+                             CountingKey<int> and the report lists comparisons / (n log2 n)
+                             and moves / n (copies and moves, a swap being three moves)
+      --rss                  Measure memory instead of time: the peak RSS growth of every
+                             sort, in kB, each run once in a fresh child process (Linux)
+      --calibrate            Measure the thresholds of autoSort on this machine and write them
+                             as a header (default SortThresholds.cpp), to be copied over
+                             helper/SortThresholds.cpp
+      --threads a,b,...      Thread scaling instead of the full comparison: the parallel sorts
+                             run on pools of each size (e.g. 1,2,4,8,16) and the report lists
+                             the speed-up of every size over the first one
+      --segments MIN,MAX     Segmented sort instead of the full comparison: every size is cut
+                             into segments of MIN to MAX elements, sorted by segmentedSort and
+                             by a loop of the other sorts over the segments
+      --save-baseline LABEL  Also store the timings as the baseline LABEL
+      --compare LABEL        Compare the timings with the baseline LABEL: the change of every
+                             cell's mean with its 95% confidence interval (Welch's t-test),
+                             a JSON verdict, and exit status 1 if anything got slower or 3
+                             if no cell of the run is in the baseline
+      --tolerance P          Smallest significant change that counts, in percent (default 5)
+      --baseline-dir DIR     Where baselines are stored (default baselines)
+      --verdict FILE         Verdict of --compare (default comparison.json)
+      --format csv|json      Output format (default csv)
+      --out FILE             Output file (default sorting_performance.csv / .json,
+                             operation_counts.csv / .json with --count,
+                             peak_memory.csv / .json with --rss,
+                             thread_scaling.csv / .json with --threads, or
+                             segmented_sort.csv / .json with --segments)
+*/
+
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <cstdlib> // For rand() and srand()
-#include <ctime>   // For random seed
-#include <chrono>  // For high-resolution timing
+#include <string>
+#include <sstream>
+#include <algorithm>   // For std::find
+#include <cmath>       // For std::log2
+#include <cstdlib>     // For std::exit
+#include <filesystem>
+#include <functional>  // For std::identity
+#include <stdexcept>   // For std::runtime_error
+#include <type_traits> // For std::is_arithmetic_v
 
 // Include the sorting algorithms
 #include "../bubble-sort.cpp"
 #include "../selection-sort.cpp"
 #include "../insertion-sort.cpp"
 #include "../merge-sort.cpp"
+#include "../adaptive-merge-sort.cpp"
+#include "../block-merge-sort.cpp"
 #include "../quick-sort.cpp"
 #include "../heap-sort.cpp"
+#include "../parallel-merge-sort.cpp"
+#include "../sample-sort.cpp"
+#include "../radix-sort.cpp"
+#include "../shell-sort.cpp"
+#include "../auto-sort.cpp"
+#include "../segmented-sort.cpp"
 
-// Function to generate random arrays
-std::vector<int> generateRandomArray(int size) {
-    std::vector<int> arr(size);
-    for (int i = 0; i < size; ++i) {
-        arr[i] = rand(); // Random integer
-    }
-    return arr;
+// Include the benchmark harness
+#include "../helper/Benchmark.cpp"
+#include "../helper/CountingKey.cpp"
+#include "../helper/PeakMemory.cpp"
+#include "../helper/Baseline.cpp"
+
+// Template function to call visit(name, quadratic, sort) for every sorting algorithm on vectors
+// of T. Every sort is its own lambda type, so the benchmark is instantiated for each of them
+// and the comparisons are inlined, as they would be in a direct call.
+// Quadratic algorithms are limited to --max-quadratic elements.
+template <typename T, typename Visit>
+void forEachAlgorithm(Visit&& visit) {
+    // Operation counters are per thread, so counted runs of the parallel sort use one thread
+    constexpr unsigned parallelThreads = std::is_arithmetic_v<T> ? 0 : 1;
+    // Radix sorts read plain numbers directly and counting keys through their value
+    auto radixKey = [] {
+        if constexpr (std::is_arithmetic_v<T>) return std::identity();
+        else return &T::value;
+    }();
+
+    visit("Bubble Sort", true, [](std::vector<T>& arr) { bubbleSort(arr); });
+    visit("Selection Sort", true, [](std::vector<T>& arr) { selectionSort(arr); });
+    visit("Insertion Sort", true, [](std::vector<T>& arr) { insertionSort(arr); });
+    visit("Merge Sort", false, [](std::vector<T>& arr) { mergeSort(arr); });
+    visit("Adaptive Merge Sort", false, [](std::vector<T>& arr) { adaptiveMergeSort(arr); });
+    visit("Block Merge Sort", false, [](std::vector<T>& arr) { blockMergeSort(arr); });
+    visit("Block Merge Sort (no buffer)", false, [](std::vector<T>& arr) {
+        blockMergeSort(arr, std::less<>(), std::identity(), 0);
+        });
+    visit("Parallel Merge Sort", false, [](std::vector<T>& arr) {
+        if (parallelThreads == 0) parallelMergeSort(arr);
+        else parallelMergeSort(arr, parallelThreads);
+        });
+    visit("Sample Sort", false, [](std::vector<T>& arr) {
+        if (parallelThreads == 0) sampleSort(arr);
+        else sampleSort(arr, parallelThreads);
+        });
+    visit("Quick Sort", false, [](std::vector<T>& arr) { quickSort(arr); });
+    visit("Quick Sort (3-way)", false, [](std::vector<T>& arr) { quickSort3Way(arr.begin(), arr.end()); });
+    visit("Quick Sort (block)", false, [](std::vector<T>& arr) { blockQuickSort(arr.begin(), arr.end()); });
+    visit("Heap Sort", false, [](std::vector<T>& arr) { heapSort(arr); });
+    visit("Shell Sort (Ciura)", false, [](std::vector<T>& arr) { shellSort<CiuraGaps>(arr); });
+    visit("Shell Sort (Tokuda)", false, [](std::vector<T>& arr) { shellSort<TokudaGaps>(arr); });
+    visit("Shell Sort (Sedgewick)", false, [](std::vector<T>& arr) { shellSort<SedgewickGaps>(arr); });
+    visit("Shell Sort (Pratt)", false, [](std::vector<T>& arr) { shellSort<PrattGaps>(arr); });
+    visit("Radix Sort (LSD 8)", false, [radixKey](std::vector<T>& arr) { radixSortLSD<8>(arr, radixKey); });
+    visit("Radix Sort (LSD 11)", false, [radixKey](std::vector<T>& arr) { radixSortLSD<11>(arr, radixKey); });
+    visit("Radix Sort (LSD 16)", false, [radixKey](std::vector<T>& arr) { radixSortLSD<16>(arr, radixKey); });
+    visit("Radix Sort (MSD)", false, [radixKey](std::vector<T>& arr) { radixSortMSD(arr, radixKey); });
+    visit("Auto Sort", false, [](std::vector<T>& arr) { autoSort(arr); });
 }
 
-// Function to log data to CSV file
-void logToCSV(const std::string& filename, int size, const std::vector<double>& times) {
-    std::ofstream file;
-    file.open(filename, std::ios::app); // Append to file
-    file << size;
-    for (double time : times) {
-        file << "," << time; // Log each time
+// Operation counts of one algorithm on one distribution and size
+struct CountResult {
+    std::string algorithm;
+    Distribution distribution;
+    size_t size;
+    OperationCounts counts;
+};
+
+// Function to count the operations of every selected algorithm and write them to a file
+void countOperations(const BenchmarkConfig& config, const std::vector<std::string>& only, size_t maxQuadratic,
+    const std::string& format, const std::string& filename) {
+    using Key = CountingKey<int>;
+    Benchmark<Key> inputs(config); // Only used to generate the same inputs as the timed runs
+    std::vector<CountResult> results;
+
+    forEachAlgorithm<Key>([&](const std::string& name, bool quadratic, auto sort) {
+        if (!only.empty() && std::find(only.begin(), only.end(), name) == only.end()) return;
+        for (Distribution distribution : config.distributions) {
+            for (size_t n : config.sizes) {
+                if (quadratic && n > maxQuadratic) continue;
+                std::vector<Key> arr = inputs.input(distribution, n);
+
+                resetOperationCounts();
+                sort(arr);
+                OperationCounts counts = operationCounts;
+
+                if (!std::is_sorted(arr.begin(), arr.end())) {
+                    std::cerr << "Warning: " << name << " did not sort " << toString(distribution)
+                        << " input of size " << n << std::endl;
+                }
+                results.push_back({ name, distribution, n, counts });
+
+                double nLogN = n > 1 ? n * std::log2(static_cast<double>(n)) : 1;
+                double moves = counts.copies + counts.moves + 3.0 * counts.swaps;
+                std::cout << name << " | " << toString(distribution) << " | n = " << n
+                    << " | comparisons / n log n " << counts.comparisons / nLogN
+                    << " | moves / n " << moves / std::max<size_t>(n, 1) << std::endl;
+            }
+        }
+        // Add a separator for better readability
+        std::cout << "----------------------------------------" << std::endl;
+        });
+
+    std::ofstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    if (format == "json") file << "{\n  \"results\": [";
+    else file << "algorithm,distribution,size,comparisons,copies,moves,swaps,comparisons_per_nlogn,moves_per_n\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const CountResult& r = results[i];
+        double nLogN = r.size > 1 ? r.size * std::log2(static_cast<double>(r.size)) : 1;
+        double movesPerN = (r.counts.copies + r.counts.moves + 3.0 * r.counts.swaps) / std::max<size_t>(r.size, 1);
+        if (format == "json") {
+            file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << r.algorithm
+                << "\", \"distribution\": \"" << toString(r.distribution) << "\", \"size\": " << r.size
+                << ", \"comparisons\": " << r.counts.comparisons << ", \"copies\": " << r.counts.copies
+                << ", \"moves\": " << r.counts.moves << ", \"swaps\": " << r.counts.swaps
+                << ", \"comparisons_per_nlogn\": " << r.counts.comparisons / nLogN
+                << ", \"moves_per_n\": " << movesPerN << "}";
+        }
+        else {
+            file << '"' << r.algorithm << "\"," << toString(r.distribution) << ',' << r.size << ','
+                << r.counts.comparisons << ',' << r.counts.copies << ',' << r.counts.moves << ','
+                << r.counts.swaps << ',' << r.counts.comparisons / nLogN << ',' << movesPerN << '\n';
+        }
     }
-    file << "\n";
-    file.close();
+    if (format == "json") file << "\n  ]\n}\n";
 }
 
-// Function to write the CSV headers dynamically
-void writeCSVHeader(const std::string& filename, const std::vector<std::pair<std::string, void (*)(std::vector<int>&)>>& sortingAlgorithms) {
+// Peak memory of one algorithm on one distribution and size
+struct MemoryResult {
+    std::string algorithm;
+    Distribution distribution;
+    size_t size;
+    long peakKB; // Growth of the peak RSS during the sort, -1 if unknown
+};
+
+// Function to measure the peak memory of every selected algorithm and write it to a file
+void measureMemory(const BenchmarkConfig& config, const std::vector<std::string>& only, size_t maxQuadratic,
+    const std::string& format, const std::string& filename) {
+    Benchmark<int> inputs(config); // Only used to generate the same inputs as the timed runs
+    std::vector<MemoryResult> results;
+
+    forEachAlgorithm<int>([&](const std::string& name, bool quadratic, auto sort) {
+        if (!only.empty() && std::find(only.begin(), only.end(), name) == only.end()) return;
+        for (Distribution distribution : config.distributions) {
+            for (size_t n : config.sizes) {
+                if (quadratic && n > maxQuadratic) continue;
+                long peakKB = measurePeakRSS([&] { return inputs.input(distribution, n); },
+                    [&](std::vector<int>& arr) { sort(arr); });
+                results.push_back({ name, distribution, n, peakKB });
+
+                std::cout << name << " | " << toString(distribution) << " | n = " << n << " | peak RSS growth ";
+                if (peakKB < 0) std::cout << "unavailable" << std::endl;
+                else std::cout << peakKB << " kB (input " << n * sizeof(int) / 1024 << " kB)" << std::endl;
+            }
+        }
+        // Add a separator for better readability
+        std::cout << "----------------------------------------" << std::endl;
+        });
+
     std::ofstream file(filename);
-    file << "Array Size"; // Start with "Array Size"
-    for (const auto& algo : sortingAlgorithms) {
-        file << "," << algo.first; // Add each algorithm name
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    if (format == "json") file << "{\n  \"results\": [";
+    else file << "algorithm,distribution,size,input_kb,peak_rss_kb\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const MemoryResult& r = results[i];
+        size_t inputKB = r.size * sizeof(int) / 1024;
+        if (format == "json") {
+            file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << r.algorithm
+                << "\", \"distribution\": \"" << toString(r.distribution) << "\", \"size\": " << r.size
+                << ", \"input_kb\": " << inputKB << ", \"peak_rss_kb\": " << r.peakKB << "}";
+        }
+        else {
+            file << '"' << r.algorithm << "\"," << toString(r.distribution) << ',' << r.size << ','
+                << inputKB << ',' << r.peakKB << '\n';
+        }
     }
-    file << "\n";
-    file.close();
+    if (format == "json") file << "\n  ]\n}\n";
 }
 
-// Function to time a sorting algorithm using the provided signature
-template <typename T>
-double timeSortingAlgorithm(void (*sortingAlgo)(std::vector<T>&), std::vector<T>& arr) {
-    auto start = std::chrono::high_resolution_clock::now();
-    sortingAlgo(arr);
-    auto end = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration<double>(end - start).count(); // Return elapsed time
+// Template function to return the median time of sort on fresh copies of input
+template <typename Sort>
+double medianSeconds(const std::vector<int>& input, Sort sort, const BenchmarkConfig& config) {
+    std::vector<double> samples;
+    for (int r = 0; r < config.warmups + config.repetitions; r++) {
+        std::vector<int> arr = input;
+        auto start = std::chrono::steady_clock::now();
+        sort(arr);
+        auto end = std::chrono::steady_clock::now();
+        if (r >= config.warmups) samples.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    return summarize(samples).median;
 }
 
-int main() {
-    // Seed for random number generation
-    std::srand(static_cast<unsigned>(std::time(0)));
-
-    // Variable to store the starting array size
-    constexpr int MIN_SIZE = 0;
-    // Variable to store the maximum array size
-    constexpr int MAX_SIZE = 100;
-    // Variable to store the step size
-    constexpr int STEP_SIZE = 100;
-
-    // Vector to store the array sizes
-    std::vector<int> sizes;
-    for (int i = MIN_SIZE; i <= MAX_SIZE; i += STEP_SIZE) {
-        sizes.push_back(i);
-    }
-
-    // Store sorting algorithms in a vector
-    std::vector<std::pair<std::string, void (*)(std::vector<int>&)>> sortingAlgorithms = {
-        {"Bubble Sort", bubbleSort},
-        {"Selection Sort", selectionSort},
-        {"Insertion Sort", insertionSort},
-        {"Merge Sort", mergeSort},
-        {"Quick Sort", quickSort},
-        {"Heap Sort", heapSort}
+// Function to measure the thresholds of autoSort and write them as a header
+void calibrate(const BenchmarkConfig& config, const std::string& filename) {
+    Benchmark<int> inputs(config);
+    auto report = [](const std::string& what, size_t n, double a, double b) {
+        std::cout << what << " | n = " << n << " | " << a << "s vs " << b << "s" << std::endl;
     };
 
-    // CSV file for logging
-    std::string filename = "sorting_performance.csv";
+    // Insertion Sort: many small arrays in a row, so that each timing is long enough. A lambda
+    // for descending order keeps the sorting networks out, as they only recognize std::less
+    // and std::greater.
+    constexpr size_t SMALL_TOTAL = 1 << 16;
+    std::vector<int> smallInput = inputs.input(Distribution::Random, SMALL_TOTAL);
+    size_t insertionMax = 0;
+    for (size_t n : { 4, 8, 12, 16, 24, 32, 48, 64, 96, 128 }) {
+        auto chunks = [n](auto sort) {
+            return [n, sort](std::vector<int>& arr) {
+                for (size_t i = 0; i + n <= arr.size(); i += n) sort(arr.begin() + i, arr.begin() + i + n);
+            };
+        };
+        auto descending = [](int a, int b) { return a > b; };
+        double insertion = medianSeconds(smallInput,
+            chunks([descending](auto first, auto last) { insertionSort(first, last, descending); }), config);
+        double quick = medianSeconds(smallInput,
+            chunks([descending](auto first, auto last) { quickSort(first, last, descending); }), config);
+        report("Insertion Sort vs Quick Sort", n, insertion, quick);
+        if (insertion > quick) break;
+        insertionMax = n;
+    }
 
-    // Write the CSV headers dynamically
-    writeCSVHeader(filename, sortingAlgorithms);
+    // Radix Sort and Sample Sort: the smallest size from which they win at every larger size
+    auto crossover = [&](const std::string& what, auto sort, size_t from, size_t to) {
+        size_t threshold = SIZE_MAX;
+        for (size_t n = from; n <= to; n *= 2) {
+            std::vector<int> input = inputs.input(Distribution::Random, n);
+            double candidate = medianSeconds(input, sort, config);
+            double quick = medianSeconds(input, [](std::vector<int>& arr) { quickSort(arr); }, config);
+            report(what + " vs Quick Sort", n, candidate, quick);
+            if (candidate < quick) threshold = std::min(threshold, n);
+            else threshold = SIZE_MAX;
+        }
+        return threshold;
+    };
+    size_t radixMin = crossover("Radix Sort (LSD 11)", [](std::vector<int>& arr) { radixSortLSD<11>(arr); }, 256, 1 << 20);
+    size_t parallelMin = SIZE_MAX;
+    if (std::thread::hardware_concurrency() > 1) {
+        parallelMin = crossover("Sample Sort", [](std::vector<int>& arr) { sampleSort(arr); }, 1 << 14, 1 << 22);
+    }
 
-    // Loop through each array size
-    for (int size : sizes) {
-        std::vector<int> arr = generateRandomArray(size);
-        std::vector<double> times(sortingAlgorithms.size());
+    // Adaptive Merge Sort: the largest fraction of run breaks at which it beats the sort that
+    // would run otherwise
+    constexpr size_t LARGE = 1 << 20;
+    auto otherwise = [radixMin](std::vector<int>& arr) {
+        if (arr.size() >= radixMin) radixSortLSD<11>(arr);
+        else quickSort(arr);
+    };
+    double presortedMax = 0;
+    for (double fraction : { 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2 }) {
+        BenchmarkConfig nearly = config;
+        nearly.swaps = static_cast<size_t>(fraction * LARGE / 3); // A swap breaks about three runs
+        std::vector<int> input = Benchmark<int>(nearly).input(Distribution::NearlySorted, LARGE);
+        std::less<> less;
+        double breaks = profileInput(input.begin(), input.end(), less, true).runBreaks;
+        double adaptive = medianSeconds(input, [](std::vector<int>& arr) { adaptiveMergeSort(arr); }, config);
+        double other = medianSeconds(input, otherwise, config);
+        report("Adaptive Merge Sort at " + std::to_string(breaks) + " run breaks vs default", LARGE, adaptive, other);
+        if (adaptive > other) break;
+        presortedMax = std::max(presortedMax, breaks);
+    }
 
-        // Time each sorting algorithm
-        for (size_t i = 0; i < sortingAlgorithms.size(); ++i) {
-            std::vector<int> tempArr = arr; // Create a copy for sorting
-            times[i] = timeSortingAlgorithm(sortingAlgorithms[i].second, tempArr); // Time the sort
-            std::cout << "Completed " << sortingAlgorithms[i].first << std::endl;
+    // 3-way Quick Sort: the smallest sampled duplicate fraction from which it wins. Descending
+    // order keeps the radix sort out, as it does for every key that is not a number.
+    double duplicatesMin = 2; // Never
+    std::mt19937_64 rng(config.seed);
+    for (size_t distinct : { 1 << 16, 1 << 12, 1 << 10, 256, 64, 16, 4 }) {
+        std::vector<int> input(LARGE);
+        for (int& x : input) x = static_cast<int>(rng() % distinct);
+        std::greater<> greater;
+        double duplicates = profileInput(input.begin(), input.end(), greater, false).duplicates;
+        double threeWay = medianSeconds(input,
+            [](std::vector<int>& arr) { quickSort3Way(arr.begin(), arr.end(), std::greater<>()); }, config);
+        double quick = medianSeconds(input, [](std::vector<int>& arr) { quickSort(arr, std::greater<>()); }, config);
+        report("Quick Sort (3-way) at " + std::to_string(duplicates) + " duplicates vs Quick Sort", LARGE, threeWay, quick);
+        if (threeWay < quick) {
+            duplicatesMin = duplicates;
+            break;
         }
+    }
 
-        // Log results to CSV
-        logToCSV(filename, size, times);
+    std::ofstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    auto size = [](size_t n) { return n == SIZE_MAX ? std::string("SIZE_MAX") : std::to_string(n); };
+    file << "/*\n"
+        << "    Thresholds of autoSort (auto-sort.cpp), measured by `analyze --calibrate`.\n"
+        << "    Regenerate this file on the target machine and copy it over helper/SortThresholds.cpp.\n\n"
+        << "    Generated on: " << std::thread::hardware_concurrency() << "-thread machine\n"
+        << "*/\n\n"
+        << "#pragma once\n\n"
+        << "#include <cstddef>\n"
+        << "#include <cstdint>\n\n"
+        << "// Arrays up to this size are insertion sorted\n"
+        << "constexpr size_t AUTO_SORT_INSERTION_MAX = " << insertionMax << ";\n\n"
+        << "// Arithmetic keys in ascending order are radix sorted from this size on\n"
+        << "constexpr size_t AUTO_SORT_RADIX_MIN = " << size(radixMin) << ";\n\n"
+        << "// Sample Sort on all hardware threads from this size on (SIZE_MAX: never)\n"
+        << "constexpr size_t AUTO_SORT_PARALLEL_MIN = " << size(parallelMin) << ";\n\n"
+        << "// Adaptive Merge Sort when at most this fraction of neighbours ends a run\n"
+        << "constexpr double AUTO_SORT_PRESORTED_MAX_RUN_BREAKS = " << presortedMax << ";\n\n"
+        << "// 3-way Quick Sort when at least this fraction of sampled neighbours are duplicates (above 1: never)\n"
+        << "constexpr double AUTO_SORT_DUPLICATES_MIN = " << duplicatesMin << ";\n";
+}
 
-        // Output to console for progress
-        std::cout << "Completed sorting for array size: " << size << std::endl;
+// Template function to call visit(name, sort) for every parallel sorting algorithm on a pool
+template <typename Visit>
+void forEachParallelAlgorithm(ThreadPool& pool, Visit&& visit) {
+    visit("Parallel Merge Sort", [&pool](std::vector<int>& arr) { parallelMergeSort(arr, pool); });
+    visit("Sample Sort", [&pool](std::vector<int>& arr) { sampleSort(arr, pool); });
+}
+
+// Function to time the parallel algorithms on pools of every given size and write the speed-up
+// of each size over the first one to a file
+void measureScaling(const BenchmarkConfig& config, const std::vector<std::string>& only,
+    const std::vector<unsigned>& threadCounts, const std::string& format, const std::string& filename) {
+    // One benchmark per pool size, so the results can be matched up by index afterwards
+    std::vector<Benchmark<int>> benchmarks;
+    for (unsigned threads : threadCounts) {
+        // The counters of --perf are opened first, so that they count the workers of the pool
+        benchmarks.emplace_back(config);
+        ThreadPool pool(threads);
+        forEachParallelAlgorithm(pool, [&](const std::string& name, auto sort) {
+            if (!only.empty() && std::find(only.begin(), only.end(), name) == only.end()) return;
+            benchmarks.back().run(name + " (" + std::to_string(threads) + " threads)", sort);
+            });
         // Add a separator for better readability
         std::cout << "----------------------------------------" << std::endl;
     }
 
+    std::ofstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    if (format == "json") file << "{\n  \"results\": [";
+    else file << "algorithm,threads,distribution,size,median_seconds,speedup\n";
+
+    const std::vector<BenchmarkResult>& base = benchmarks[0].results();
+    bool firstRow = true;
+    for (size_t t = 0; t < threadCounts.size(); t++) {
+        const std::vector<BenchmarkResult>& results = benchmarks[t].results();
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& r = results[i];
+            std::string algorithm = r.algorithm.substr(0, r.algorithm.rfind(" ("));
+            double speedup = r.seconds.median > 0 ? base[i].seconds.median / r.seconds.median : 0;
+            if (t > 0) {
+                std::cout << algorithm << " | " << toString(r.distribution) << " | n = " << r.size << " | "
+                    << threadCounts[t] << " threads | speed-up " << speedup << std::endl;
+            }
+            if (format == "json") {
+                file << (firstRow ? "\n" : ",\n") << "    {\"algorithm\": \"" << algorithm << "\", \"threads\": "
+                    << threadCounts[t] << ", \"distribution\": \"" << toString(r.distribution) << "\", \"size\": "
+                    << r.size << ", \"median_seconds\": " << r.seconds.median << ", \"speedup\": " << speedup << "}";
+            }
+            else {
+                file << '"' << algorithm << "\"," << threadCounts[t] << ',' << toString(r.distribution) << ','
+                    << r.size << ',' << r.seconds.median << ',' << speedup << '\n';
+            }
+            firstRow = false;
+        }
+    }
+    if (format == "json") file << "\n  ]\n}\n";
+}
+
+// Template function to call visit(name, sort) for every way of sorting the segments of a
+// vector, segment i being [offsets[i], offsets[i + 1])
+template <typename Visit>
+void forEachSegmentedAlgorithm(const std::vector<size_t>& offsets, ThreadPool& pool, Visit&& visit) {
+    // Turn sort(first, last) into a sort of every segment on its own
+    auto perSegment = [&offsets](auto sort) {
+        return [&offsets, sort](std::vector<int>& arr) {
+            for (size_t s = 0; s + 1 < offsets.size(); s++) sort(arr.begin() + offsets[s], arr.begin() + offsets[s + 1]);
+        };
+    };
+
+    visit("Segmented Sort", [&offsets, &pool](std::vector<int>& arr) { segmentedSort(arr, offsets, pool); });
+    visit("Segmented Sort (1 thread)", [&offsets](std::vector<int>& arr) { segmentedSort(arr, offsets, 1u); });
+    visit("Merge Sort per segment", perSegment([](auto first, auto last) { mergeSort(first, last); }));
+    visit("Quick Sort per segment", perSegment([](auto first, auto last) { quickSort(first, last); }));
+    visit("Insertion Sort per segment", perSegment([](auto first, auto last) { insertionSort(first, last); }));
+}
+
+// Segmented sort timing of one algorithm on one distribution and size
+struct SegmentedResult {
+    std::string algorithm;
+    Distribution distribution;
+    size_t size;
+    size_t segments;
+    double seconds; // Median
+};
+
+// Function to time segmentedSort against a loop of the other sorts over segments of minLength
+// to maxLength elements, and write the results to a file
+void measureSegmented(const BenchmarkConfig& config, const std::vector<std::string>& only,
+    size_t minLength, size_t maxLength, const std::string& format, const std::string& filename) {
+    Benchmark<int> inputs(config); // Only used to generate the same inputs as the timed runs
+    ThreadPool pool(std::thread::hardware_concurrency());
+    std::vector<SegmentedResult> results;
+
+    for (Distribution distribution : config.distributions) {
+        for (size_t n : config.sizes) {
+            // Segment lengths are uniform in [minLength, maxLength], the last one cut at n
+            std::mt19937_64 rng(config.seed);
+            std::vector<size_t> offsets = { 0 };
+            while (offsets.back() < n) {
+                size_t length = minLength + rng() % (maxLength - minLength + 1);
+                offsets.push_back(std::min(offsets.back() + std::max<size_t>(length, 1), n));
+            }
+            std::vector<int> input = inputs.input(distribution, n);
+
+            forEachSegmentedAlgorithm(offsets, pool, [&](const std::string& name, auto sort) {
+                if (!only.empty() && std::find(only.begin(), only.end(), name) == only.end()) return;
+                std::vector<int> check = input;
+                sort(check);
+                for (size_t s = 0; s + 1 < offsets.size(); s++) {
+                    if (!std::is_sorted(check.begin() + offsets[s], check.begin() + offsets[s + 1])) {
+                        std::cerr << "Warning: " << name << " did not sort segment " << s << " of "
+                            << toString(distribution) << " input of size " << n << std::endl;
+                        break;
+                    }
+                }
+
+                double seconds = medianSeconds(input, sort, config);
+                results.push_back({ name, distribution, n, offsets.size() - 1, seconds });
+                std::cout << name << " | " << toString(distribution) << " | n = " << n << " | "
+                    << offsets.size() - 1 << " segments | median " << seconds << "s" << std::endl;
+                });
+            // Add a separator for better readability
+            std::cout << "----------------------------------------" << std::endl;
+        }
+    }
+
+    std::ofstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    if (format == "json") file << "{\n  \"results\": [";
+    else file << "algorithm,distribution,size,segments,min_length,max_length,median_seconds\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const SegmentedResult& r = results[i];
+        if (format == "json") {
+            file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << r.algorithm
+                << "\", \"distribution\": \"" << toString(r.distribution) << "\", \"size\": " << r.size
+                << ", \"segments\": " << r.segments << ", \"min_length\": " << minLength
+                << ", \"max_length\": " << maxLength << ", \"median_seconds\": " << r.seconds << "}";
+        }
+        else {
+            file << '"' << r.algorithm << "\"," << toString(r.distribution) << ',' << r.size << ','
+                << r.segments << ',' << minLength << ',' << maxLength << ',' << r.seconds << '\n';
+        }
+    }
+    if (format == "json") file << "\n  ]\n}\n";
+}
+
+// Function to split a comma-separated list
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Function to print the usage and exit
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--sizes a,b,c | --min N --max N (--step N | --factor F)]\n"
+        << "       [--dist a,b,...|all] [--swaps K] [--reps N] [--warmup N] [--seed N]\n"
+        << "       [--only a,b,...] [--max-quadratic N] [--perf | --count | --rss | --calibrate | --threads a,b,... | --segments MIN,MAX]\n"
+        << "       [--save-baseline LABEL] [--compare LABEL [--tolerance P] [--verdict FILE]] [--baseline-dir DIR]\n"
+        << "       [--format csv|json] [--out FILE]" << std::endl;
+    std::exit(1);
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    size_t minSize = 0, maxSize = 0, step = 0;
+    double factor = 0;
+    size_t maxQuadratic = 32768;
+    std::vector<std::string> only;
+    std::string format = "csv";
+    std::string filename;
+    bool count = false;
+    bool rss = false;
+    bool calibration = false;
+    std::string saveLabel, compareLabel;
+    std::string baselineDirectory = "baselines";
+    std::string verdictFile = "comparison.json";
+    double tolerance = 5;
+    std::vector<unsigned> threadCounts;
+    size_t minSegment = 0, maxSegment = 0;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--perf") {
+            config.perfCounters = true;
+            continue;
+        }
+        if (option == "--count") {
+            count = true;
+            continue;
+        }
+        if (option == "--rss") {
+            rss = true;
+            continue;
+        }
+        if (option == "--calibrate") {
+            calibration = true;
+            continue;
+        }
+        if (i + 1 >= argc) usage(argv[0]);
+        std::string value = argv[++i];
+
+        if (option == "--sizes") {
+            config.sizes.clear();
+            for (const std::string& size : splitList(value)) config.sizes.push_back(std::stoull(size));
+        }
+        else if (option == "--min") minSize = std::stoull(value);
+        else if (option == "--max") maxSize = std::stoull(value);
+        else if (option == "--step") step = std::stoull(value);
+        else if (option == "--factor") factor = std::stod(value);
+        else if (option == "--dist") {
+            config.distributions.clear();
+            if (value == "all") {
+                for (const auto& entry : distributionNames()) config.distributions.push_back(entry.first);
+            }
+            else {
+                for (const std::string& name : splitList(value)) config.distributions.push_back(parseDistribution(name));
+            }
+        }
+        else if (option == "--swaps") config.swaps = std::stoull(value);
+        else if (option == "--reps") config.repetitions = std::stoi(value);
+        else if (option == "--warmup") config.warmups = std::stoi(value);
+        else if (option == "--seed") config.seed = std::stoull(value);
+        else if (option == "--only") only = splitList(value);
+        else if (option == "--max-quadratic") maxQuadratic = std::stoull(value);
+        else if (option == "--threads") {
+            threadCounts.clear();
+            for (const std::string& threads : splitList(value)) threadCounts.push_back(static_cast<unsigned>(std::stoul(threads)));
+        }
+        else if (option == "--segments") {
+            std::vector<std::string> lengths = splitList(value);
+            if (lengths.size() != 2) usage(argv[0]);
+            minSegment = std::stoull(lengths[0]);
+            maxSegment = std::stoull(lengths[1]);
+            if (maxSegment == 0 || minSegment > maxSegment) usage(argv[0]);
+        }
+        else if (option == "--save-baseline") saveLabel = value;
+        else if (option == "--compare") compareLabel = value;
+        else if (option == "--tolerance") tolerance = std::stod(value);
+        else if (option == "--baseline-dir") baselineDirectory = value;
+        else if (option == "--verdict") verdictFile = value;
+        else if (option == "--format") format = value;
+        else if (option == "--out") filename = value;
+        else usage(argv[0]);
+    }
+
+    // Size sweep from --min/--max, either linear or geometric
+    if (maxSize != 0) {
+        config.sizes.clear();
+        for (size_t n = std::max<size_t>(minSize, 1); n <= maxSize;) {
+            config.sizes.push_back(n);
+            size_t next = factor > 1 ? static_cast<size_t>(n * factor) : n + (step != 0 ? step : 1);
+            n = std::max(next, n + 1);
+        }
+    }
+    if (format != "csv" && format != "json") usage(argv[0]);
+    if (filename.empty() && calibration) filename = "SortThresholds.cpp";
+    if (filename.empty()) {
+        filename = (count ? "operation_counts." : rss ? "peak_memory." :
+            !threadCounts.empty() ? "thread_scaling." : maxSegment != 0 ? "segmented_sort." :
+            "sorting_performance.") + format;
+    }
+
+    // Count operations instead of timing
+    if (count) {
+        countOperations(config, only, maxQuadratic, format, filename);
+        std::cout << "Results written to " << filename << std::endl;
+        return 0;
+    }
+
+    // Measure the thresholds of autoSort
+    if (calibration) {
+        calibrate(config, filename);
+        std::cout << "Thresholds written to " << filename << std::endl;
+        return 0;
+    }
+
+    // Measure peak memory instead of timing
+    if (rss) {
+        measureMemory(config, only, maxQuadratic, format, filename);
+        std::cout << "Results written to " << filename << std::endl;
+        return 0;
+    }
+
+    // Speed-up of the parallel sorts over thread counts
+    if (!threadCounts.empty()) {
+        measureScaling(config, only, threadCounts, format, filename);
+        std::cout << "Results written to " << filename << std::endl;
+        return 0;
+    }
+
+    // Segmented sort against a loop of the other sorts
+    if (maxSegment != 0) {
+        measureSegmented(config, only, minSegment, maxSegment, format, filename);
+        std::cout << "Results written to " << filename << std::endl;
+        return 0;
+    }
+
+    // Time every selected algorithm
+    Benchmark<int> benchmark(config);
+    forEachAlgorithm<int>([&](const std::string& name, bool quadratic, auto sort) {
+        if (!only.empty() && std::find(only.begin(), only.end(), name) == only.end()) return;
+        benchmark.run(name, sort, quadratic ? maxQuadratic : SIZE_MAX);
+        // Add a separator for better readability
+        std::cout << "----------------------------------------" << std::endl;
+        });
+
+    // Log results to the output file
+    if (format == "json") benchmark.writeJSON(filename);
+    else benchmark.writeCSV(filename);
+    std::cout << "Results written to " << filename << std::endl;
+
+    // Store the run as a baseline
+    if (!saveLabel.empty()) {
+        std::filesystem::create_directories(baselineDirectory);
+        std::string baselineFile = (std::filesystem::path(baselineDirectory) / (saveLabel + ".csv")).string();
+        benchmark.writeCSV(baselineFile);
+        std::cout << "Baseline " << saveLabel << " written to " << baselineFile << std::endl;
+    }
+
+    // Compare the run with a baseline
+    if (!compareLabel.empty()) {
+        std::string baselineFile = (std::filesystem::path(baselineDirectory) / (compareLabel + ".csv")).string();
+        std::vector<BaselineRow> current;
+        for (const BenchmarkResult& result : benchmark.results()) current.push_back(toBaselineRow(result));
+        RunComparison comparison;
+        try {
+            comparison = compareRuns(readBaseline(baselineFile), current, tolerance);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 2;
+        }
+
+        for (const CellComparison& c : comparison.cells) {
+            std::cout << c.current.algorithm << " | " << c.current.distribution << " | n = " << c.current.size
+                << " | " << (c.deltaPercent >= 0 ? "+" : "") << c.deltaPercent << "% [" << c.lowPercent << "%, "
+                << c.highPercent << "%] | " << toString(c.change) << std::endl;
+        }
+        for (const BaselineRow& row : comparison.unmatched) {
+            std::cout << row.algorithm << " | " << row.distribution << " | n = " << row.size
+                << " | not measured" << std::endl;
+        }
+        bool pass = writeVerdict(verdictFile, compareLabel, tolerance, comparison);
+        std::cout << "Compared " << comparison.cells.size() << " cells with baseline " << compareLabel << " ("
+            << comparison.unmatched.size() << " baseline cells not measured): "
+            << (pass ? "pass" : "fail") << " (verdict written to " << verdictFile << ")" << std::endl;
+        if (comparison.cells.empty()) {
+            std::cerr << "Error: no cell of the run is in baseline " << compareLabel << std::endl;
+            return 3;
+        }
+        if (!pass) return 1;
+    }
 
     return 0;
 }
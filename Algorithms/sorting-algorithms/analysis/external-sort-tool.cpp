@@ -0,0 +1,185 @@
+/*
+    Driver of the external sort on files of 100-byte records (an 8-byte key and a payload).
+
+    Build: g++ -std=c++20 -O2 -pthread external-sort-tool.cpp -o external-sort-tool
+
+    Usage: external-sort-tool [options] INPUT OUTPUT
+      --memory MB            Memory budget (default 1024)
+      --buffer KB            Read / write buffer size during the merge (default 1024)
+      --tmp DIR              Directory of the temporary runs (default system temp directory)
+      --verify               Check that OUTPUT is sorted and holds the records of INPUT, each
+                             once (INPUT must be written by --generate)
+
+    Usage: external-sort-tool --generate N FILE [--seed S]
+      Write N records with random keys to FILE
+
+    Usage: external-sort-tool --self-test N [--memory MB] [--buffer KB] [--tmp DIR]
+      Generate N records in a temporary file, sort them, verify the output and remove both
+*/
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstdlib>     // For std::exit
+#include <cstring>     // For std::memcpy
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include "../external-sort.cpp"
+
+// Fixed-width record sorted by key
+struct Record {
+    uint64_t key;
+    char payload[92];
+};
+
+// Function to write n records with random keys to a file
+void generateRecords(const std::string& path, size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    RecordWriter<Record> writer(path, (size_t(1) << 20) / sizeof(Record));
+    Record record{};
+    for (size_t i = 0; i < n; i++) {
+        record.key = rng();
+        std::memcpy(record.payload, &i, sizeof(i)); // Tag the record with its position
+        writer.push(record);
+    }
+    writer.close();
+}
+
+// Function to hash the key and payload of a record (FNV-1a), so that a sum of hashes does not
+// depend on the order of the records
+uint64_t hashRecord(const Record& record) {
+    unsigned char bytes[sizeof(record.key) + sizeof(record.payload)];
+    std::memcpy(bytes, &record.key, sizeof(record.key));
+    std::memcpy(bytes + sizeof(record.key), record.payload, sizeof(record.payload));
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char byte : bytes) hash = (hash ^ byte) * 1099511628211ull;
+    return hash;
+}
+
+// Function to check that the output file is sorted by key and holds the records of the input
+// file, each once: the position tags written by generateRecords must form a permutation of
+// 0..N-1, and the sum of the record hashes must match, so no record is lost, duplicated or torn
+bool verifyRecords(const std::string& input, const std::string& output) {
+    const size_t bufferRecords = (size_t(1) << 20) / sizeof(Record);
+    size_t expected = 0;
+    uint64_t inputHash = 0;
+    for (RecordReader<Record> reader(input, bufferRecords); !reader.empty(); reader.pop(), expected++) {
+        inputHash += hashRecord(reader.front());
+    }
+
+    RecordReader<Record> reader(output, bufferRecords);
+    std::vector<bool> seen(expected, false);
+    size_t count = 0;
+    uint64_t previous = 0, outputHash = 0;
+    for (; !reader.empty(); reader.pop(), count++) {
+        const Record& record = reader.front();
+        if (count > 0 && record.key < previous) {
+            std::cerr << "Record " << count << " is out of order" << std::endl;
+            return false;
+        }
+        previous = record.key;
+        size_t tag;
+        std::memcpy(&tag, record.payload, sizeof(tag));
+        if (tag >= expected || seen[tag]) {
+            std::cerr << "Record " << count << " has a " << (tag >= expected ? "bad" : "repeated")
+                << " position tag " << tag << std::endl;
+            return false;
+        }
+        seen[tag] = true;
+        outputHash += hashRecord(record);
+    }
+    if (count != expected) {
+        std::cerr << "Expected " << expected << " records, found " << count << std::endl;
+        return false;
+    }
+    if (outputHash != inputHash) {
+        std::cerr << "The records differ from the input records" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Function to sort a file and print the measurements
+ExternalSortStats sortFile(const std::string& input, const std::string& output, const ExternalSortConfig& config) {
+    ExternalSortStats stats = externalSort<Record>(input, output, config, std::less<>(), &Record::key);
+    std::cout << "Sorted " << stats.records << " records (" << stats.bytes / 1e6 << " MB) in "
+        << stats.totalSeconds << " s: " << stats.throughput() << " MB/s\n"
+        << "  Run generation: " << stats.runs << " runs in " << stats.runSeconds << " s\n"
+        << "  Merge: " << stats.mergePasses << " passes in " << stats.mergeSeconds << " s" << std::endl;
+    return stats;
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--memory MB] [--buffer KB] [--tmp DIR] [--verify] INPUT OUTPUT\n"
+        << "       " << program << " --generate N FILE [--seed S]\n"
+        << "       " << program << " --self-test N [--memory MB] [--buffer KB] [--tmp DIR]" << std::endl;
+    std::exit(1);
+}
+
+int main(int argc, char* argv[]) {
+    ExternalSortConfig config;
+    std::vector<std::string> files;
+    size_t generate = 0, selfTest = 0;
+    uint64_t seed = 42;
+    bool verify = false;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--verify") {
+            verify = true;
+            continue;
+        }
+        if (option.rfind("--", 0) != 0) {
+            files.push_back(option);
+            continue;
+        }
+        if (i + 1 >= argc) usage(argv[0]);
+        std::string value = argv[++i];
+
+        if (option == "--memory") config.memoryBudget = std::stoull(value) << 20;
+        else if (option == "--buffer") config.ioBufferSize = std::stoull(value) << 10;
+        else if (option == "--tmp") config.tempDirectory = value;
+        else if (option == "--generate") generate = std::stoull(value);
+        else if (option == "--self-test") selfTest = std::stoull(value);
+        else if (option == "--seed") seed = std::stoull(value);
+        else usage(argv[0]);
+    }
+
+    try {
+        if (generate != 0) {
+            if (files.size() != 1) usage(argv[0]);
+            generateRecords(files[0], generate, seed);
+            return 0;
+        }
+
+        if (selfTest != 0) {
+            namespace fs = std::filesystem;
+            fs::path directory = config.tempDirectory.empty() ? fs::temp_directory_path() : fs::path(config.tempDirectory);
+            std::string input = (directory / "external-sort-input.bin").string();
+            std::string output = (directory / "external-sort-output.bin").string();
+            generateRecords(input, selfTest, seed);
+            sortFile(input, output, config);
+            bool sorted = verifyRecords(input, output);
+            fs::remove(input);
+            fs::remove(output);
+            std::cout << (sorted ? "Output verified" : "Output verification failed") << std::endl;
+            return sorted ? 0 : 1;
+        }
+
+        if (files.size() != 2) usage(argv[0]);
+        sortFile(files[0], files[1], config);
+        if (verify) {
+            bool sorted = verifyRecords(files[0], files[1]);
+            std::cout << (sorted ? "Output verified" : "Output verification failed") << std::endl;
+            return sorted ? 0 : 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+    Benchmark of listMergeSort on intrusive linked lists of ints (doubly linked) and of strings
+    (singly linked), against copying the items out into a vector, sorting it with mergeSort
+    and writing the items back along the list.
+    The nodes are laid out in list order (--layout sequential) or shuffled in memory (--layout
+    scattered), which is what a list gets after many insertions and removals.
+
+    Build: g++ -std=c++20 -O2 list-sort-benchmark.cpp -o list-sort-benchmark
+
+    Usage: list-sort-benchmark [options]
+      --nodes N              Number of items (default 10000000)
+      --reps N               Timed repetitions per method (default 3)
+      --seed N               Seed of the items (default 42)
+      --layout L             sequential or scattered (default scattered)
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>     // For std::exit
+#include <algorithm>   // For std::shuffle
+#include <numeric>     // For std::iota
+#include <random>
+#include <utility>     // For std::move
+
+#include "../list-merge-sort.cpp"
+#include "../merge-sort.cpp"
+#include "../helper/Benchmark.cpp" // For summarize
+
+// Node of a doubly linked list of ints
+struct IntNode {
+    int item;
+    IntNode* next;
+    IntNode* prev;
+};
+
+// Node of a singly linked list of strings
+struct StringNode {
+    std::string item;
+    StringNode* next;
+};
+
+// Template struct of a list whose nodes live in one array, linked in the order of items
+template <typename Node>
+struct NodeList {
+    std::vector<Node> nodes;
+    Node* head = nullptr;
+    Node* tail = nullptr;
+};
+
+// Template function to link the nodes in the order given by slots: the i-th item goes to node
+// slots[i]
+template <typename Node, typename T>
+void fillList(NodeList<Node>& list, const std::vector<T>& items, const std::vector<size_t>& slots) {
+    list.nodes.resize(items.size());
+    list.head = list.tail = nullptr;
+    for (size_t i = 0; i < items.size(); i++) {
+        Node* node = &list.nodes[slots[i]];
+        node->item = items[i];
+        node->next = nullptr;
+        if constexpr (requires { &Node::prev; }) node->prev = list.tail;
+        if (list.tail != nullptr) list.tail->next = node;
+        else list.head = node;
+        list.tail = node;
+    }
+}
+
+// Template function to check that the items are in ascending order from head to tail
+template <typename Node>
+bool isSortedList(const NodeList<Node>& list) {
+    for (const Node* node = list.head; node != nullptr && node->next != nullptr; node = node->next) {
+        if (node->next->item < node->item) return false;
+    }
+    return true;
+}
+
+// Template function to sort the list by relinking its nodes
+template <typename Node>
+void relinkSort(NodeList<Node>& list) {
+    auto less = [](const Node* a, const Node* b) { return a->item < b->item; };
+    if constexpr (requires { &Node::prev; }) {
+        list.head = listMergeSort(list.head, &Node::next, less, &Node::prev, &list.tail);
+    }
+    else {
+        list.head = listMergeSort(list.head, &Node::next, less);
+    }
+}
+
+// Template function to sort the list by moving its items into a vector, sorting them there and
+// moving them back along the list
+template <typename Node>
+void copySort(NodeList<Node>& list) {
+    std::vector<decltype(Node::item)> items;
+    items.reserve(list.nodes.size());
+    for (Node* node = list.head; node != nullptr; node = node->next) items.push_back(std::move(node->item));
+    mergeSort(items);
+    size_t i = 0;
+    for (Node* node = list.head; node != nullptr; node = node->next) node->item = std::move(items[i++]);
+}
+
+// Template function to time sort on lists filled with items, and print the median
+template <typename Node, typename T, typename Sort>
+void measure(const std::string& name, const std::vector<T>& items, const std::vector<size_t>& slots,
+    int repetitions, Sort sort) {
+    std::vector<double> samples;
+    NodeList<Node> list;
+    for (int r = 0; r < repetitions; r++) {
+        fillList(list, items, slots);
+        auto start = std::chrono::steady_clock::now();
+        sort(list);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double>(end - start).count());
+        if (r == 0 && !isSortedList(list)) std::cerr << "Warning: " << name << " did not sort" << std::endl;
+    }
+    Statistics stats = summarize(samples);
+    std::cout << name << " | median " << stats.median << "s [p5 " << stats.p5 << "s, p95 " << stats.p95 << "s]" << std::endl;
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--nodes N] [--reps N] [--seed N] [--layout sequential|scattered]" << std::endl;
+    std::exit(1);
+}
+
+int main(int argc, char* argv[]) {
+    size_t nodes = 10000000;
+    int repetitions = 3;
+    uint64_t seed = 42;
+    bool scattered = true;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) usage(argv[0]);
+        std::string value = argv[++i];
+
+        if (option == "--nodes") nodes = std::stoull(value);
+        else if (option == "--reps") repetitions = std::stoi(value);
+        else if (option == "--seed") seed = std::stoull(value);
+        else if (option == "--layout" && (value == "sequential" || value == "scattered")) scattered = value == "scattered";
+        else usage(argv[0]);
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<int> numbers(nodes);
+    for (int& x : numbers) x = static_cast<int>(rng());
+    std::vector<std::string> strings(nodes);
+    for (std::string& s : strings) s = "item_" + std::to_string(rng() % 1000000000);
+    std::vector<size_t> slots(nodes);
+    std::iota(slots.begin(), slots.end(), 0);
+    if (scattered) std::shuffle(slots.begin(), slots.end(), rng);
+
+    measure<IntNode>("int list listMergeSort", numbers, slots, repetitions, relinkSort<IntNode>);
+    measure<IntNode>("int list copy-out/copy-in", numbers, slots, repetitions, copySort<IntNode>);
+    std::cout << "----------------------------------------" << std::endl;
+
+    measure<StringNode>("string list listMergeSort", strings, slots, repetitions, relinkSort<StringNode>);
+    measure<StringNode>("string list copy-out/copy-in", strings, slots, repetitions, copySort<StringNode>);
+    std::cout << "----------------------------------------" << std::endl;
+
+    return 0;
+}
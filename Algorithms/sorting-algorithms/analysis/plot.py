@@ -1,40 +1,72 @@
+import sys
+import json
 import pandas as pd
 import matplotlib.pyplot as plt
 
-# Read the CSV file
-data = pd.read_csv("algorithms/sorting-algorithms/analysis/sorting_performance.csv")
+# Results file written by analyze (CSV or JSON), given on the command line
+filename = sys.argv[1] if len(sys.argv) > 1 else "algorithms/sorting-algorithms/analysis/sorting_performance.csv"
+output = sys.argv[2] if len(sys.argv) > 2 else "algorithms/sorting-algorithms/analysis/sorting_algorithm_performance.png"
+
+# Read the results: one row per (algorithm, distribution, size)
+comparison = None
+if filename.endswith(".json"):
+    with open(filename) as file:
+        results = json.load(file)
+    data = pd.DataFrame(results["results"])
+    # A verdict of analyze --compare holds changes against a baseline instead of timings
+    if "verdict" in results:
+        comparison = results
+else:
+    data = pd.read_csv(filename)
 
 pd.set_option("display.float_format", "{:.6f}".format)
 print(data)
 
+# One plot per input distribution
+distributions = data["distribution"].unique()
+figure, axes = plt.subplots(len(distributions), 1, figsize=(10, 6 * len(distributions)), squeeze=False)
 
-# Extract the columns dynamically (excluding "Array Size")
-algorithms = data.columns[1:]  # Exclude the "Array Size" column
+for ax, distribution in zip(axes[:, 0], distributions):
+    subset = data[data["distribution"] == distribution]
 
-# Create the plot
-plt.figure(figsize=(10, 6))
+    # Comparison with a baseline: the change of every cell with its 95% confidence interval
+    if comparison is not None:
+        for algo, rows in subset.groupby("algorithm", sort=False):
+            rows = rows.sort_values("size")
+            errors = [rows["delta_percent"] - rows["ci_low_percent"], rows["ci_high_percent"] - rows["delta_percent"]]
+            ax.errorbar(rows["size"], rows["delta_percent"], yerr=errors, marker="o", capsize=3, label=algo)
+        ax.axhline(comparison["tolerance_percent"], color="red", linestyle="--", linewidth=1)
+        ax.axhline(0, color="black", linewidth=1)
+        ax.set_xlabel("Size of Array (n)")
+        ax.set_ylabel("Change of the mean time (%)")
+        ax.set_title(f"Change against baseline {comparison['baseline']}: {comparison['verdict']} ({distribution} input)")
+        ax.set_xscale("log")
+        ax.legend()
+        ax.grid(True)
+        continue
 
-# Plot each sorting algorithm's time against the array size dynamically
-for algo in algorithms:
-    plt.plot(
-        data["Array Size"],
-        data[algo],
-        label=algo,  # Use the algorithm name for the label
-    )
+    # Plot the median time of each algorithm, with the p5-p95 range shaded
+    for algo, rows in subset.groupby("algorithm", sort=False):
+        rows = rows.sort_values("size")
+        ax.plot(rows["size"], rows["median"], marker="o", label=algo)
+        ax.fill_between(rows["size"], rows["p5"], rows["p95"], alpha=0.2)
 
-# Add labels and title
-plt.xlabel("Size of Array (n)")
-plt.ylabel("Time Taken (seconds)")
-plt.title("Sorting Algorithm Performance Comparison")
+    # Add labels and title
+    ax.set_xlabel("Size of Array (n)")
+    ax.set_ylabel("Time Taken (seconds, median)")
+    ax.set_title(f"Sorting Algorithm Performance Comparison ({distribution} input)")
+    ax.set_xscale("log")
+    ax.set_yscale("log")
 
-# Add a legend to differentiate between the algorithms
-plt.legend()
+    # Add a legend to differentiate between the algorithms
+    ax.legend()
+    # Show grid
+    ax.grid(True)
 
-# Show grid and improve layout
-plt.grid(True)
+# Improve layout
 plt.tight_layout()
 
 # Save the plot as a PNG file
-plt.savefig("algorithms/sorting-algorithms/analysis/sorting_algorithm_performance.png")
+plt.savefig(output)
 # Show the plot
 plt.show()
@@ -0,0 +1,148 @@
+/*
+    Auto Sort:
+    - A single entry point that looks at a small sample of the input and hands it to the
+      algorithm that suits it best, so callers do not have to guess between the sorts.
+    - The profile of the input is cheap to take, O(1) comparisons whatever n is:
+      - size, element width and whether the key is a number in ascending order,
+      - presortedness: how often neighbours turn from ascending to descending or back, in 64
+        short windows spread over the array, which estimates the number of runs,
+      - duplicates: the fraction of equal neighbours in a sorted sample of up to 128 elements.
+    - The choice, in order:
+      - small arrays: Insertion Sort, or a sorting network for integers in ascending or
+        descending order,
+      - few runs (nearly sorted, reversed, organ pipes): Adaptive Merge Sort, which uses them,
+      - large arrays on a multi-core machine: Sample Sort on all hardware threads,
+      - numbers in ascending order: LSD Radix Sort,
+      - many duplicates: 3-way Quick Sort,
+      - anything else: Quick Sort (block partitioning for numbers, 3-way otherwise).
+    - The thresholds come from helper/SortThresholds.cpp, generated on the target machine
+      by `analyze --calibrate`.
+    - The name avoids `sort`, which std::sort would make ambiguous through argument-dependent
+      lookup on standard iterators.
+
+    Time Complexity: O(n log n) in the worst case, O(n) for presorted inputs and radix keys.
+    Space Complexity: Depends on the chosen algorithm, O(n) at most.
+    In-Place: No
+    Stable: No
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>   // For std::min
+#include <functional>  // For std::invoke, std::identity
+#include <iterator>
+#include <thread>      // For std::thread::hardware_concurrency
+#include <type_traits>
+
+#include "insertion-sort.cpp"
+#include "adaptive-merge-sort.cpp"
+#include "quick-sort.cpp"
+#include "radix-sort.cpp"
+#include "sample-sort.cpp"
+#include "sorting-network.cpp"
+#include "helper/SortInterface.cpp"
+#include "helper/SortThresholds.cpp"
+
+// Windows and pairs per window sampled for presortedness
+constexpr size_t AUTO_SORT_WINDOWS = 64;
+constexpr size_t AUTO_SORT_WINDOW_PAIRS = 8;
+
+// Elements sampled for duplicates
+constexpr size_t AUTO_SORT_SAMPLE = 128;
+
+// What autoSort knows about its input
+struct SortProfile {
+    size_t size = 0;
+    size_t elementBytes = 0;
+    bool radixKey = false;  // The key is a number and the order is ascending
+    double runBreaks = 0;   // Sampled fraction of neighbours that end an ascending or descending run
+    double duplicates = 0;  // Sampled fraction of equal neighbours after sorting
+
+    // Estimated number of ascending or descending runs
+    size_t runs() const {
+        return size == 0 ? 0 : 1 + static_cast<size_t>(runBreaks * static_cast<double>(size - 1));
+    }
+};
+
+// Template function to profile [first, last) for autoSort
+template <typename RandomIt, typename Less>
+SortProfile profileInput(RandomIt first, RandomIt last, Less& less, bool radixKey) {
+    SortProfile profile;
+    profile.size = static_cast<size_t>(last - first);
+    profile.elementBytes = sizeof(std::iter_value_t<RandomIt>);
+    profile.radixKey = radixKey;
+    size_t n = profile.size;
+    if (n < 2) return profile;
+
+    // Presortedness: short windows of neighbours, evenly spread
+    size_t windows = std::min(AUTO_SORT_WINDOWS, (n - 1) / AUTO_SORT_WINDOW_PAIRS + 1);
+    size_t pairs = 0, breaks = 0;
+    for (size_t w = 0; w < windows; w++) {
+        size_t start = w * (n - 1) / windows;
+        size_t end = std::min(start + AUTO_SORT_WINDOW_PAIRS, n - 1);
+        int direction = 0; // 1 ascending, -1 descending, 0 not known yet (equal neighbours so far)
+        for (size_t i = start; i < end; i++, pairs++) {
+            int step = less(first[i + 1], first[i]) ? -1 : less(first[i], first[i + 1]) ? 1 : 0;
+            if (step == 0) continue;
+            if (direction != 0 && step != direction) breaks++;
+            direction = step;
+        }
+    }
+    profile.runBreaks = static_cast<double>(breaks) / static_cast<double>(pairs);
+
+    // Duplicates: sort a sample of positions by their elements and count equal neighbours.
+    // The positions are offset from the windows so that they see other elements.
+    size_t samples = std::min(AUTO_SORT_SAMPLE, n / 8 + 2);
+    std::vector<size_t> sample(samples);
+    for (size_t s = 0; s < samples; s++) sample[s] = (s * n + n / 2) / samples;
+    auto byIndex = [&less, first](size_t a, size_t b) { return less(first[a], first[b]); };
+    quickSort(sample.begin(), sample.end(), byIndex);
+    size_t equal = 0;
+    for (size_t s = 1; s < samples; s++) {
+        if (!byIndex(sample[s - 1], sample[s])) equal++;
+    }
+    profile.duplicates = samples > 1 ? static_cast<double>(equal) / static_cast<double>(samples - 1) : 0;
+    return profile;
+}
+
+// Template function to sort [first, last) with the algorithm that suits the input
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void autoSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, std::iter_reference_t<RandomIt>>>;
+    constexpr bool radixKey = isNaturalOrder<Compare> && std::is_arithmetic_v<Key>;
+    auto less = projectedLess(comp, proj);
+
+    size_t n = static_cast<size_t>(last - first);
+    if (n <= AUTO_SORT_INSERTION_MAX) {
+        if (!sortSmall(first, last, less)) {
+            insertionSortBy(first, last, less);
+        }
+        return;
+    }
+
+    SortProfile profile = profileInput(first, last, less, radixKey);
+    if (profile.runBreaks <= AUTO_SORT_PRESORTED_MAX_RUN_BREAKS) {
+        adaptiveMergeSortBy(first, last, less);
+    }
+    else if (n >= AUTO_SORT_PARALLEL_MIN && std::thread::hardware_concurrency() > 1) {
+        sampleSort(first, last, comp, proj);
+    }
+    else if constexpr (radixKey) {
+        if (n >= AUTO_SORT_RADIX_MIN) radixSortLSD<11>(first, last, proj);
+        else quickSort(first, last, comp, proj);
+    }
+    else if (profile.duplicates >= AUTO_SORT_DUPLICATES_MIN) {
+        quickSort3Way(first, last, comp, proj);
+    }
+    else {
+        quickSort(first, last, comp, proj);
+    }
+}
+
+// Template function to sort a range with the algorithm that suits the input
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void autoSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    autoSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
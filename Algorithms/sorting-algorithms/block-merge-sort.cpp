@@ -0,0 +1,235 @@
+/*
+    Block Merge Sort:
+    - A stable merge sort that needs only a small buffer, of about sqrt(n) elements by
+      default, instead of the n / 2 elements of Merge Sort.
+    - Sub-arrays of up to 16 elements are sorted directly and merged pairwise, like in Merge
+      Sort. How two sorted runs A and B are merged depends on the buffer:
+      - If the shorter run fits in the buffer, it is moved there and merged back directly.
+      - If a block of s >= sqrt(|A| + |B|) elements fits, the runs are merged by blocks
+        (Kronrod's block merge). A and B are cut into blocks of s elements, and the blocks are
+        reordered by their first elements, which is a merge of two sorted lists of about
+        sqrt(n) blocks. The blocks are moved into place by following the cycles of that
+        permutation, with the buffer holding one block. Then a single pass merges each block
+        with the leftover of the blocks before it, through the buffer. The few elements that
+        do not fill a whole block, at the start of A and the end of B, are merged last.
+      - Otherwise the runs are split by rotations (SymMerge): the middle of the longer run is
+        found in the shorter one by binary search, the two middle pieces are swapped with a
+        rotation, and both halves are merged recursively, until they fit one of the cases above.
+    - The buffer size is a knob: 0 gives an O(1) memory sort built only on rotations, the
+      default of sqrt(n) keeps every merge linear, and n / 2 makes it a plain Merge Sort.
+
+    Time Complexity:
+    - Best Case: O(n log n) - Merges of runs already in order are skipped with one comparison.
+    - Average Case: O(n log n) - With a buffer of sqrt(n) elements or more.
+    - Worst Case: O(n log n) - O(n log^2 n) moves without a buffer.
+
+    Space Complexity: O(sqrt(n)) - The buffer and the block order, O(1) without a buffer
+    (plus an O(log n) recursion stack).
+    In-Place: Yes (with a buffer of O(sqrt(n)) elements)
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm> // For std::lower_bound, std::upper_bound, std::rotate
+#include <cmath>     // For std::sqrt
+#include <cstdint>
+#include <iterator>  // For std::iter_value_t, std::make_move_iterator
+#include <utility>   // For std::move
+
+#include "insertion-sort.cpp"        // Used for small sub-arrays
+#include "sorting-network.cpp"      // Used for small sub-arrays of integer keys
+#include "merge-sort.cpp"            // Merges whose left run fits in the buffer
+#include "helper/SortInterface.cpp"
+
+// Sub-arrays up to this size are sorted without recursing
+constexpr int BLOCK_MERGE_SORT_CUTOFF = 16;
+
+// Buffer size that means "about sqrt(n) elements"
+constexpr size_t BLOCK_MERGE_SQRT_BUFFER = SIZE_MAX;
+
+// Template function to merge [first, mid) and [mid, last) by moving the right run to the buffer
+// and merging from the back
+template <typename RandomIt, typename T, typename Less>
+void mergeFromRight(RandomIt first, RandomIt mid, RandomIt last, std::vector<T>& buffer, Less& less) {
+    buffer.assign(std::make_move_iterator(mid), std::make_move_iterator(last));
+
+    auto i = buffer.end(); // One past the next element of the right run
+    RandomIt j = mid;      // One past the next element of the left run
+    RandomIt k = last;     // One past the next output position, never before j
+
+    while (i != buffer.begin() && j != first) {
+        // Take from the left run only if it is strictly greater, to keep the merge stable
+        if (less(*(i - 1), *(j - 1))) {
+            *--k = std::move(*--j);
+        }
+        else {
+            *--k = std::move(*--i);
+        }
+    }
+
+    // Move the rest of the right run, if any. The rest of the left run is in place.
+    std::move_backward(buffer.begin(), i, k);
+}
+
+// Template function to merge [first, mid) and [mid, last), both made of whole blocks of s
+// elements, with a buffer of at least s elements
+template <typename RandomIt, typename T, typename Less>
+void blockMerge(RandomIt first, RandomIt mid, RandomIt last, size_t s, std::vector<T>& buffer, Less& less) {
+    size_t blocksA = static_cast<size_t>(mid - first) / s;
+    size_t blocks = static_cast<size_t>(last - first) / s;
+    auto block = [first, s](size_t b) { return first + b * s; };
+
+    // Merge the blocks of A and B by their first elements. Ties go to A, so an A block never
+    // follows a B block that starts with an equal element.
+    std::vector<size_t> order; // order[p] is the block that goes to position p
+    order.reserve(blocks);
+    size_t a = 0, b = blocksA;
+    while (a < blocksA && b < blocks) {
+        order.push_back(less(*block(b), *block(a)) ? b++ : a++);
+    }
+    while (a < blocksA) order.push_back(a++);
+    while (b < blocks) order.push_back(b++);
+
+    // Move the blocks to their positions, one cycle of the permutation at a time
+    std::vector<bool> fromA(blocks);
+    for (size_t p = 0; p < blocks; p++) fromA[p] = order[p] < blocksA;
+    for (size_t p = 0; p < blocks; p++) {
+        if (order[p] == p) continue; // In place, or an already rotated cycle
+
+        buffer.assign(std::make_move_iterator(block(p)), std::make_move_iterator(block(p) + s));
+        size_t q = p;
+        while (order[q] != p) {
+            size_t next = order[q];
+            std::move(block(next), block(next) + s, block(q));
+            order[q] = q; // Mark as placed
+            q = next;
+        }
+        std::move(buffer.begin(), buffer.end(), block(q));
+        order[q] = q;
+    }
+
+    // Every element of a block is final once it is no greater than the rest of the blocks
+    // after it. The leftover [rest, block(p)) of the blocks before p is merged with block p
+    // when they come from different runs; otherwise it is final as it is.
+    RandomIt rest = block(0);
+    bool restFromA = fromA[0];
+    for (size_t p = 1; p < blocks; p++) {
+        RandomIt x = block(p), xEnd = x + s;
+        if (fromA[p] == restFromA) {
+            rest = x;
+            continue;
+        }
+
+        buffer.assign(std::make_move_iterator(rest), std::make_move_iterator(x));
+        auto i = buffer.begin();
+        RandomIt j = x, k = rest;
+        while (i != buffer.end() && j != xEnd) {
+            // Ties go to the element of A
+            bool takeBlock = restFromA ? less(*j, *i) : !less(*i, *j);
+            if (takeBlock) {
+                *k++ = std::move(*j++);
+            }
+            else {
+                *k++ = std::move(*i++);
+            }
+        }
+
+        if (i == buffer.end()) {
+            // The leftover ran out: the rest of block p is the new leftover
+            rest = j;
+            restFromA = fromA[p];
+        }
+        else {
+            // Block p ran out: the leftover moves to the end of it
+            std::move(i, buffer.end(), k);
+            rest = k;
+        }
+    }
+}
+
+// Template function to merge the sorted runs [first, mid) and [mid, last) with a buffer of at
+// most capacity elements
+template <typename RandomIt, typename T, typename Less>
+void mergeInPlace(RandomIt first, RandomIt mid, RandomIt last, std::vector<T>& buffer, size_t capacity, Less& less) {
+    if (first == mid || mid == last || !less(*mid, *(mid - 1))) return; // Already in order
+
+    size_t leftLength = static_cast<size_t>(mid - first);
+    size_t rightLength = static_cast<size_t>(last - mid);
+    if (leftLength <= capacity) {
+        merge(first, mid, last, buffer, less);
+        return;
+    }
+    if (rightLength <= capacity) {
+        mergeFromRight(first, mid, last, buffer, less);
+        return;
+    }
+
+    size_t s = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leftLength + rightLength))));
+    if (s <= capacity) {
+        // Merge the whole blocks, then the partial block at the start of A and at the end of B.
+        // Both are shorter than s, so they fit in the buffer.
+        RandomIt blocksFirst = first + leftLength % s;
+        RandomIt blocksLast = last - rightLength % s;
+        blockMerge(blocksFirst, mid, blocksLast, s, buffer, less);
+        if (blocksLast != last) mergeFromRight(blocksFirst, blocksLast, last, buffer, less);
+        if (blocksFirst != first) merge(first, blocksFirst, last, buffer, less);
+        return;
+    }
+
+    // Split both runs around the middle of the longer one. Elements of B equal to the middle
+    // of A stay after it, and elements of A equal to the middle of B stay before it.
+    RandomIt leftCut, rightCut;
+    if (leftLength >= rightLength) {
+        leftCut = first + leftLength / 2;
+        rightCut = std::lower_bound(mid, last, *leftCut, less);
+    }
+    else {
+        rightCut = mid + rightLength / 2;
+        leftCut = std::upper_bound(first, mid, *rightCut, less);
+    }
+    RandomIt newMid = std::rotate(leftCut, mid, rightCut);
+    mergeInPlace(first, leftCut, newMid, buffer, capacity, less);
+    mergeInPlace(newMid, rightCut, last, buffer, capacity, less);
+}
+
+// Template function to perform Block Merge Sort on [first, last) with a comparator on elements
+template <typename RandomIt, typename T, typename Less>
+void blockMergeSortBy(RandomIt first, RandomIt last, std::vector<T>& buffer, size_t capacity, Less& less) {
+    if (last - first <= BLOCK_MERGE_SORT_CUTOFF) {
+        if (!sortSmall(first, last, less)) {
+            insertionSortBy(first, last, less);
+        }
+        return;
+    }
+
+    RandomIt mid = first + (last - first) / 2;
+    blockMergeSortBy(first, mid, buffer, capacity, less);
+    blockMergeSortBy(mid, last, buffer, capacity, less);
+    mergeInPlace(first, mid, last, buffer, capacity, less);
+}
+
+// Template function to perform Block Merge Sort with a buffer of at most bufferSize elements
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void blockMergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj(),
+    size_t bufferSize = BLOCK_MERGE_SQRT_BUFFER) {
+    auto less = projectedLess(comp, proj);
+    size_t n = static_cast<size_t>(last - first);
+    if (bufferSize == BLOCK_MERGE_SQRT_BUFFER) {
+        bufferSize = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+    }
+    bufferSize = std::min(bufferSize, n / 2); // Every merge fits from n / 2 on
+
+    std::vector<std::iter_value_t<RandomIt>> buffer;
+    buffer.reserve(bufferSize);
+    blockMergeSortBy(first, last, buffer, bufferSize, less);
+}
+
+// Template function to perform Block Merge Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void blockMergeSort(Range&& range, Compare comp = Compare(), Proj proj = Proj(),
+    size_t bufferSize = BLOCK_MERGE_SQRT_BUFFER) {
+    blockMergeSort(std::ranges::begin(range), std::ranges::end(range), comp, proj, bufferSize);
+}
@@ -16,20 +16,26 @@
     Bubble Sort is not recommended for large data sets as it is not efficient.
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <algorithm> // For std::iter_swap
+
+#include "helper/SortInterface.cpp"
 
 // Template function to perform Bubble Sort
-template <typename T>
-void bubbleSort(std::vector<T>& arr) {
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
     // Get the size of the array
-    int n = arr.size();
-    for (int i = 0; i < n - 1; i++) {
+    auto n = last - first;
+    for (decltype(n) i = 0; i < n - 1; i++) {
         bool swapped = false;
-        for (int j = 0; j < n - i - 1;j++) {
-            if (arr[j] > arr[j + 1]) {
+        for (decltype(n) j = 0; j < n - i - 1; j++) {
+            if (less(first[j + 1], first[j])) {
                 // Swap the elements if they are in the wrong order
-                std::swap(arr[j], arr[j + 1]);
+                std::iter_swap(first + j, first + j + 1);
                 swapped = true;
             }
         }
@@ -37,4 +43,10 @@ void bubbleSort(std::vector<T>& arr) {
         if (!swapped)
             break;
     }
-}
\ No newline at end of file
+}
+
+// Template function to perform Bubble Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void bubbleSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    bubbleSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -0,0 +1,83 @@
+/*
+    Co-Sort:
+    - Sorts a key column and any number of payload columns in lockstep, for data stored as
+      a structure of arrays (timestamps, user ids, amounts, ...) rather than an array of
+      records. The columns are never packed into tuples: every column stays contiguous.
+    - The permutation that sorts the keys is built once with argsort (see indirect-sort.cpp):
+      a radix sort of (key prefix, index) pairs for numbers and strings in ascending order,
+      a merge sort of the indices otherwise.
+    - Then every column, keys included, is gathered through the permutation into a scratch
+      column and copied back. The gather writes sequentially and the copy back is a plain
+      contiguous copy (a memmove for trivially copyable columns), so each column costs two
+      streaming passes, however many columns there are.
+    - Columns are any contiguous ranges: std::vector, std::span, std::array, arrays.
+
+    Time Complexity:
+    - O(n) for the permutation when the keys are integers in ascending order, O(n log n)
+      comparisons otherwise.
+    - Plus O(n) moves per column.
+
+    Space Complexity: O(n) - The permutation and one scratch column at a time.
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>  // For std::move
+#include <concepts>   // For std::predicate
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <functional> // For std::less
+#include <utility>    // For std::move
+
+#include "indirect-sort.cpp" // Builds the permutation
+#include "helper/SortInterface.cpp"
+
+// Template function to rearrange a column so that the element at i is the one that was at perm[i]
+template <std::ranges::contiguous_range Column>
+void gatherColumn(Column& column, const std::vector<size_t>& perm) {
+    using T = std::ranges::range_value_t<Column>;
+    auto data = std::ranges::data(column);
+
+    std::vector<T> scratch;
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+        // A plain indexed loop, without the capacity checks of push_back
+        scratch.resize(perm.size());
+        for (size_t i = 0; i < perm.size(); i++) scratch[i] = data[perm[i]];
+    }
+    else {
+        scratch.reserve(perm.size());
+        for (size_t index : perm) scratch.push_back(std::move(data[index]));
+    }
+    std::move(scratch.begin(), scratch.end(), data);
+}
+
+// Template function to sort a key column and payload columns by the keys, with a comparator
+template <std::ranges::contiguous_range Keys, typename Compare, std::ranges::contiguous_range... Columns>
+    requires std::predicate<Compare&, std::ranges::range_reference_t<Keys>, std::ranges::range_reference_t<Keys>>
+void coSort(Keys&& keys, Compare comp, Columns&&... columns) {
+    size_t n = static_cast<size_t>(std::ranges::size(keys));
+    if (((static_cast<size_t>(std::ranges::size(columns)) != n) || ...)) {
+        throw std::invalid_argument("Columns must have as many elements as the keys");
+    }
+
+    std::vector<size_t> perm = argsort(std::ranges::begin(keys), std::ranges::end(keys), comp);
+
+    // Nothing to move if the keys were already sorted
+    bool sorted = true;
+    for (size_t i = 0; i < n && sorted; i++) sorted = perm[i] == i;
+    if (sorted) return;
+
+    gatherColumn(keys, perm);
+    (gatherColumn(columns, perm), ...);
+}
+
+// Template function to sort a key column and payload columns by the keys, in ascending order
+template <std::ranges::contiguous_range Keys, std::ranges::contiguous_range... Columns>
+void coSort(Keys&& keys, Columns&&... columns) {
+    coSort(keys, std::less<>(), columns...);
+}
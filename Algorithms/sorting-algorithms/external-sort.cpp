@@ -0,0 +1,372 @@
+/*
+    External Sort:
+    - Sorts a binary file of fixed-width records (any trivially copyable T) that may be much
+      larger than the memory available, using two phases.
+    - Run generation: the input is read in chunks of half the memory budget. Every chunk is
+      sorted in memory with quickSort and written to a temporary run file. The next chunk is
+      read on a second thread while the current one is sorted and written (double buffering),
+      so the sort overlaps with the I/O.
+    - Merging: up to `fanIn` runs are merged at once with a loser tree. Every run is read
+      through its own buffer with large sequential reads, the next buffer being prefetched
+      on another thread. The output is written the same way, so the merge never waits on a
+      write. If there are more runs than fit in memory, groups of them are merged into
+      longer runs first (multi-pass merge).
+    - Files are read front to back only, and on Linux the kernel is told so
+      (posix_fadvise SEQUENTIAL), which enlarges its read-ahead.
+
+    Loser Tree:
+    - A tournament tree over k sorted sources whose internal nodes store the loser of the
+      match played there, and whose root stores the overall winner. Replacing the winner
+      replays only the matches on its path to the root: log2(k) comparisons per element,
+      against about 2 log2(k) for a binary heap. Ties are won by the lower source index, so
+      the merge is stable.
+
+    Time Complexity (N records, memory M, fan-in k):
+    - O(N log N) comparisons
+    - I/O: every record is read and written 1 + ceil(log_k(N / (M / 2))) times
+
+    Space Complexity: O(M) - The memory budget, plus disk space for the runs.
+    In-Place: No
+    Stable: No (runs are sorted with quickSort; the merge itself is stable)
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>   // For std::min
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>  // For std::less, std::identity
+#include <future>
+#include <memory>      // For std::unique_ptr
+#include <stdexcept>
+#include <string>
+#include <type_traits> // For std::is_trivially_copyable_v
+#include <utility>     // For std::move, std::swap
+
+#ifdef __linux__
+#include <fcntl.h> // For posix_fadvise
+#endif
+
+#include "quick-sort.cpp"             // Sorts the runs
+#include "helper/SortInterface.cpp"
+
+// Settings of an external sort
+struct ExternalSortConfig {
+    size_t memoryBudget = size_t(1) << 30;   // Bytes of records held in memory at once
+    size_t ioBufferSize = size_t(1) << 20;   // Bytes per read or write buffer during the merge
+    std::string tempDirectory;               // Where runs are written (default: system temp directory)
+};
+
+// Measurements of an external sort
+struct ExternalSortStats {
+    size_t records = 0;
+    size_t bytes = 0;          // Size of the input
+    size_t runs = 0;           // Sorted runs written by the run generation
+    size_t mergePasses = 0;    // Passes over the data during the merge
+    double runSeconds = 0;     // Run generation
+    double mergeSeconds = 0;   // All merge passes
+    double totalSeconds = 0;
+
+    // Input size sorted per second, in MB/s
+    double throughput() const {
+        return totalSeconds > 0 ? bytes / 1e6 / totalSeconds : 0;
+    }
+};
+
+// Class owning a binary file opened for sequential reading or writing
+class BinaryFile {
+private:
+    std::FILE* file = nullptr;
+    std::string path;
+
+public:
+    BinaryFile(const std::string& path, const char* mode) : path(path) {
+        file = std::fopen(path.c_str(), mode);
+        if (file == nullptr) throw std::runtime_error("Cannot open " + path);
+        std::setvbuf(file, nullptr, _IONBF, 0); // Our own buffers are large enough
+#ifdef __linux__
+        posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    ~BinaryFile() {
+        if (file != nullptr) std::fclose(file);
+    }
+
+    BinaryFile(const BinaryFile&) = delete;
+    BinaryFile& operator=(const BinaryFile&) = delete;
+
+    // Read up to `bytes` bytes, returning how many were read (less only at the end of the file)
+    size_t read(void* data, size_t bytes) {
+        size_t got = std::fread(data, 1, bytes, file);
+        if (got < bytes && std::ferror(file)) throw std::runtime_error("Cannot read " + path);
+        return got;
+    }
+
+    // Write `bytes` bytes
+    void write(const void* data, size_t bytes) {
+        if (std::fwrite(data, 1, bytes, file) != bytes) throw std::runtime_error("Cannot write " + path);
+    }
+
+    // Flush and close the file, reporting errors that a destructor could not
+    void close() {
+        if (file != nullptr && std::fclose(file) != 0) {
+            file = nullptr;
+            throw std::runtime_error("Cannot write " + path);
+        }
+        file = nullptr;
+    }
+};
+
+// Template class reading records of a file through two buffers: one is consumed while the
+// other is being filled on another thread
+template <typename T>
+class RecordReader {
+private:
+    BinaryFile file;
+    std::vector<T> current, next;
+    size_t position = 0, count = 0;
+    std::future<size_t> pending; // Records read into `next`
+
+    // Start filling `next` in the background
+    void prefetch() {
+        pending = std::async(std::launch::async, [this] {
+            return file.read(next.data(), next.size() * sizeof(T)) / sizeof(T);
+            });
+    }
+
+    // Swap in the prefetched buffer and start reading the one after it
+    void refill() {
+        count = pending.get();
+        position = 0;
+        std::swap(current, next);
+        if (count > 0) prefetch();
+    }
+
+public:
+    RecordReader(const std::string& path, size_t bufferRecords)
+        : file(path, "rb"), current(std::max<size_t>(bufferRecords, 1)), next(current.size()) {
+        prefetch();
+        refill();
+    }
+
+    ~RecordReader() {
+        if (pending.valid()) pending.wait();
+    }
+
+    // Whether every record has been consumed
+    bool empty() const {
+        return position == count;
+    }
+
+    // The next record
+    const T& front() const {
+        return current[position];
+    }
+
+    // Consume the next record
+    void pop() {
+        if (++position == count) refill();
+    }
+};
+
+// Template class writing records to a file through two buffers: one is filled while the
+// other is being written on another thread
+template <typename T>
+class RecordWriter {
+private:
+    BinaryFile file;
+    std::vector<T> current, writing;
+    size_t count = 0;
+    std::future<void> pending;
+
+    // Write the full buffer in the background
+    void flushAsync() {
+        if (pending.valid()) pending.get();
+        std::swap(current, writing);
+        pending = std::async(std::launch::async, [this, bytes = count * sizeof(T)] {
+            file.write(writing.data(), bytes);
+            });
+        count = 0;
+    }
+
+public:
+    RecordWriter(const std::string& path, size_t bufferRecords)
+        : file(path, "wb"), current(std::max<size_t>(bufferRecords, 1)), writing(current.size()) {}
+
+    ~RecordWriter() {
+        if (pending.valid()) pending.wait();
+    }
+
+    // Append a record
+    void push(const T& record) {
+        current[count++] = record;
+        if (count == current.size()) flushAsync();
+    }
+
+    // Write the remaining records and close the file
+    void close() {
+        if (count > 0) flushAsync();
+        if (pending.valid()) pending.get();
+        file.close();
+    }
+};
+
+// Template class of a loser tree merging k sorted sources. A source has empty(), front()
+// and pop(); an exhausted source loses against every other one.
+template <typename Source, typename Less>
+class LoserTree {
+private:
+    std::vector<Source*> sources;
+    std::vector<size_t> tree; // tree[0] is the winner, tree[1..k) the loser of each match
+    Less& less;
+
+    // Whether source a wins against source b
+    bool beats(size_t a, size_t b) {
+        if (sources[a]->empty()) return false;
+        if (sources[b]->empty()) return true;
+        if (less(sources[a]->front(), sources[b]->front())) return true;
+        if (less(sources[b]->front(), sources[a]->front())) return false;
+        return a < b; // Ties go to the earlier source
+    }
+
+    // Play all the matches below `node`, returning the winner
+    size_t build(size_t node) {
+        size_t k = sources.size();
+        if (node >= k) return node - k; // A leaf is a source
+        size_t left = build(2 * node), right = build(2 * node + 1);
+        if (beats(left, right)) {
+            tree[node] = right;
+            return left;
+        }
+        tree[node] = left;
+        return right;
+    }
+
+public:
+    LoserTree(std::vector<Source*> sources, Less& less) : sources(std::move(sources)), tree(this->sources.size()), less(less) {
+        if (!this->sources.empty()) tree[0] = this->sources.size() == 1 ? 0 : build(1);
+    }
+
+    // Whether every source is exhausted
+    bool empty() const {
+        return sources.empty() || sources[tree[0]]->empty();
+    }
+
+    // The smallest front of all sources
+    const auto& front() const {
+        return sources[tree[0]]->front();
+    }
+
+    // Consume the smallest front and replay the matches on its path
+    void pop() {
+        size_t winner = tree[0];
+        sources[winner]->pop();
+        for (size_t node = (winner + sources.size()) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) std::swap(tree[node], winner);
+        }
+        tree[0] = winner;
+    }
+};
+
+// Template function to merge the sorted run files into `output` with a loser tree
+template <typename T, typename Less>
+void mergeRunFiles(const std::vector<std::string>& runs, const std::string& output, size_t bufferRecords, Less& less) {
+    std::vector<std::unique_ptr<RecordReader<T>>> readers;
+    std::vector<RecordReader<T>*> sources;
+    for (const std::string& run : runs) {
+        readers.push_back(std::make_unique<RecordReader<T>>(run, bufferRecords));
+        sources.push_back(readers.back().get());
+    }
+
+    RecordWriter<T> writer(output, bufferRecords);
+    LoserTree<RecordReader<T>, Less> tree(sources, less);
+    while (!tree.empty()) {
+        writer.push(tree.front());
+        tree.pop();
+    }
+    writer.close();
+}
+
+// Template function to sort the records of the file `input` into the file `output`
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+ExternalSortStats externalSort(const std::string& input, const std::string& output,
+    const ExternalSortConfig& config = ExternalSortConfig(), Compare comp = Compare(), Proj proj = Proj()) {
+    static_assert(std::is_trivially_copyable_v<T>, "External sort needs fixed-width, trivially copyable records");
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    auto less = projectedLess(comp, proj);
+
+    ExternalSortStats stats;
+    auto start = Clock::now();
+    fs::path tempDirectory = config.tempDirectory.empty() ? fs::temp_directory_path() : fs::path(config.tempDirectory);
+    std::string prefix = (tempDirectory / ("external-sort-" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()) + "-")).string();
+    size_t nextRunId = 0;
+    auto newRunPath = [&] { return prefix + std::to_string(nextRunId++) + ".run"; };
+
+    size_t inputBytes = fs::file_size(input);
+    if (inputBytes % sizeof(T) != 0) throw std::runtime_error(input + " is not a whole number of records");
+
+    // Run generation: read the next chunk while the current one is sorted and written
+    size_t chunkRecords = std::max<size_t>(std::min(config.memoryBudget / 2 / sizeof(T), inputBytes / sizeof(T)), 1);
+    std::vector<std::string> runs;
+    {
+        BinaryFile in(input, "rb");
+        std::vector<T> current(chunkRecords), next(chunkRecords);
+        auto readChunk = [&in](std::vector<T>& chunk) { return in.read(chunk.data(), chunk.size() * sizeof(T)) / sizeof(T); };
+
+        size_t count = readChunk(current);
+        while (count > 0) {
+            std::future<size_t> pending = std::async(std::launch::async, readChunk, std::ref(next));
+
+            quickSort(current.begin(), current.begin() + count, less);
+            runs.push_back(newRunPath());
+            BinaryFile run(runs.back(), "wb");
+            run.write(current.data(), count * sizeof(T));
+            run.close();
+            stats.records += count;
+
+            count = pending.get();
+            std::swap(current, next);
+        }
+    }
+    stats.bytes = stats.records * sizeof(T);
+    stats.runs = runs.size();
+    auto runsDone = Clock::now();
+    stats.runSeconds = std::chrono::duration<double>(runsDone - start).count();
+
+    // Merging: every open run and the output hold two buffers each
+    size_t bufferRecords = std::max<size_t>(config.ioBufferSize / sizeof(T), 1);
+    size_t fanIn = std::max<size_t>(config.memoryBudget / (2 * bufferRecords * sizeof(T)), 3) - 1;
+
+    if (runs.empty()) {
+        BinaryFile(output, "wb").close();
+    }
+    while (!runs.empty()) {
+        stats.mergePasses++;
+        if (runs.size() <= fanIn) {
+            mergeRunFiles<T>(runs, output, bufferRecords, less);
+            for (const std::string& run : runs) fs::remove(run);
+            break;
+        }
+
+        // Too many runs for one merge: merge groups of fanIn runs into longer runs
+        std::vector<std::string> merged;
+        for (size_t i = 0; i < runs.size(); i += fanIn) {
+            std::vector<std::string> group(runs.begin() + i, runs.begin() + std::min(i + fanIn, runs.size()));
+            merged.push_back(newRunPath());
+            mergeRunFiles<T>(group, merged.back(), bufferRecords, less);
+            for (const std::string& run : group) fs::remove(run);
+        }
+        runs = std::move(merged);
+    }
+
+    auto end = Clock::now();
+    stats.mergeSeconds = std::chrono::duration<double>(end - runsDone).count();
+    stats.totalSeconds = std::chrono::duration<double>(end - start).count();
+    return stats;
+}
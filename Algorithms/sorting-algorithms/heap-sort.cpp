@@ -5,61 +5,153 @@
      element from the heap.
     - The extracted elements are placed at the end of the array, resulting in a sorted array.
 
+    This version:
+    - Works on any random-access range with any comparator and projection, using 0-based indexing.
+    - Uses a 4-ary heap: the tree is half as deep as a binary heap and the children of a node
+     sit next to each other, usually on the same cache line.
+    - Sifts down bottom-up (Floyd): the hole at the root is first pushed all the way down along
+     the largest children, then the displaced element is sifted up from the leaf. The element
+     coming from the end of the array almost always belongs near the bottom, so this saves
+     the comparison against it at every level.
+    - Also provides partialSort (the smallest k elements, sorted, in front) and topK (the k
+     largest elements of a sequence, in descending order, using O(k) memory).
+
     Time Complexity:
-    - Best Case: O(n)
+    - Best Case: O(n log n)
     - Average Case: O(n log n)
     - Worst Case: O(n log n)
+    - partialSort / topK: O(n log k)
 
     Space Complexity: O(1)
     In-Place: Yes
     Stable: No
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <algorithm>  // For std::min
+#include <functional> // For std::less
+#include <iterator>   // For std::iterator_traits
+#include <utility>    // For std::move
 
-// Function to perform iterative heapify on a max heap using 1-based indexing
-void heapify(std::vector<int>& arr, int n, int i) {
-    int largest = i; // Initialize largest as root
-    while (true) {
-        int left = 2 * i;     // Left child (1-based indexing)
-        int right = 2 * i + 1; // Right child (1-based indexing)
+#include "helper/SortInterface.cpp"
 
-        // If the left child is larger than the root
-        if (left <= n && arr[left] > arr[largest]) {
-            largest = left;
-        }
+// Number of children per heap node
+constexpr size_t HEAP_ARITY = 4;
+
+// Template function to place `value` into the hole at index `hole` of the max heap first[0..n),
+// pushing the hole down to a leaf along the largest children and then sifting the value up
+template <typename RandomIt, typename T, typename Compare>
+void heapPlace(RandomIt first, size_t n, size_t hole, T value, Compare& comp) {
+    size_t top = hole;
 
-        // If the right child is larger than the largest so far
-        if (right <= n && arr[right] > arr[largest]) {
-            largest = right;
+    // Move the largest child up into the hole until the hole reaches a leaf
+    while (true) {
+        size_t child = HEAP_ARITY * hole + 1;
+        if (child >= n) break;
+        size_t end = std::min(child + HEAP_ARITY, n);
+        size_t largest = child;
+        for (size_t c = child + 1; c < end; c++) {
+            if (comp(first[largest], first[c])) largest = c;
         }
+        first[hole] = std::move(first[largest]);
+        hole = largest;
+    }
 
-        // If the largest is not the root
-        if (largest != i) {
-            std::swap(arr[i], arr[largest]); // Swap root with largest
+    // Sift the value up from the leaf while its parent is smaller
+    while (hole > top) {
+        size_t parent = (hole - 1) / HEAP_ARITY;
+        if (!comp(first[parent], value)) break;
+        first[hole] = std::move(first[parent]);
+        hole = parent;
+    }
+    first[hole] = std::move(value);
+}
 
-            // Move to the largest node and continue heapifying
-            i = largest;
-        }
-        else {
-            break; // Exit loop if the heap property is satisfied
+// Template function to rearrange first[0..n) into a max heap
+template <typename RandomIt, typename Compare>
+void makeHeap(RandomIt first, size_t n, Compare& comp) {
+    if (n < 2) return;
+    // Sift down every internal node, starting from the last one
+    for (size_t i = (n - 2) / HEAP_ARITY + 1; i-- > 0;) {
+        heapPlace(first, n, i, std::move(first[i]), comp);
+    }
+}
+
+// Template function to turn the max heap first[0..n) into a sorted range
+template <typename RandomIt, typename Compare>
+void sortHeap(RandomIt first, size_t n, Compare& comp) {
+    // One by one move the root to the end and refill the root from there
+    for (size_t end = n; end-- > 1;) {
+        auto value = std::move(first[end]);
+        first[end] = std::move(first[0]);
+        heapPlace(first, end, 0, std::move(value), comp);
+    }
+}
+
+// Template function to perform heap sort on [first, last)
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    size_t n = last - first;
+    makeHeap(first, n, less);
+    sortHeap(first, n, less);
+}
+
+// Template function to perform heap sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void heapSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    heapSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
+
+// Template function to put the (middle - first) smallest elements of [first, last) in sorted
+// order at the front. The order of the remaining elements is unspecified.
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    size_t k = middle - first;
+    if (k == 0) return;
+
+    // Keep the k smallest elements seen so far in a max heap, whose root is the largest of them
+    makeHeap(first, k, less);
+    for (RandomIt it = middle; it != last; ++it) {
+        if (less(*it, *first)) {
+            // Swap the element with the root and let it sink
+            auto value = std::move(*it);
+            *it = std::move(*first);
+            heapPlace(first, k, 0, std::move(value), less);
         }
     }
+    sortHeap(first, k, less);
 }
 
-// Function to perform heap sort using max heap
-void heapSort(std::vector<int>& arr) {
-    int n = arr.size() - 1; // Size of the heap (adjusted for 1-based indexing)
+// Template function to return the k largest elements of [first, last) in descending order,
+// reading the input once and keeping only k elements in memory
+template <std::input_iterator InputIt, typename Compare = std::less<>, typename Proj = std::identity>
+std::vector<typename std::iterator_traits<InputIt>::value_type>
+topK(InputIt first, InputIt last, size_t k, Compare comp = Compare(), Proj proj = Proj()) {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    auto less = projectedLess(comp, proj);
+    // With the comparison reversed, the root of the heap is the smallest element kept
+    auto reversed = [&less](const T& a, const T& b) { return less(b, a); };
 
-    // Build the max heap (rearrange the array)
-    for (int i = n / 2; i >= 1; --i) {
-        heapify(arr, n, i);
+    std::vector<T> heap;
+    heap.reserve(k);
+    for (; first != last && heap.size() < k; ++first) {
+        heap.push_back(*first);
     }
+    makeHeap(heap.begin(), heap.size(), reversed);
 
-    // One by one extract elements from the heap
-    for (int i = n; i > 1; --i) {
-        std::swap(arr[1], arr[i]); // Move the current root to the end
-        heapify(arr, i - 1, 1);    // Heapify the reduced heap
+    // Replace the smallest kept element whenever a larger one comes along
+    for (; first != last; ++first) {
+        if (k > 0 && less(heap[0], *first)) {
+            heapPlace(heap.begin(), k, 0, T(*first), reversed);
+        }
     }
-}
\ No newline at end of file
+
+    // Sorting by the reversed comparison gives descending order
+    sortHeap(heap.begin(), heap.size(), reversed);
+    return heap;
+}
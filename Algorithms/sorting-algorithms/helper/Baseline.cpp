@@ -0,0 +1,221 @@
+/*
+    Baselines of benchmark results and regression checks against them:
+    - A baseline is a results CSV written by Benchmark::writeCSV and stored under a label
+      (baselines/LABEL.csv by default), so that later runs can be compared with it.
+    - Every cell (algorithm, distribution, size) found in both runs is compared on its mean
+      time with Welch's t-test, which does not assume equal variances. The report gives the
+      change of the mean in percent with its 95% confidence interval.
+    - A cell is a regression when the whole interval lies above zero and the change is
+      larger than a tolerance (5% by default), so that neither noise nor tiny but
+      consistent differences fail the check. Improvements are the mirror case.
+    - The verdict is written as JSON: "pass" or "fail", the number of regressions and
+      improvements, every compared cell, and the baseline cells the run did not measure.
+      A comparison that matched no cell fails, so a run with other sizes or names than its
+      baseline cannot pass by comparing nothing.
+*/
+
+#pragma once
+
+#include <algorithm> // For std::max
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Benchmark.cpp"
+
+// Summary of one cell, as stored in a results file
+struct BaselineRow {
+    std::string algorithm;
+    std::string distribution;
+    size_t size = 0;
+    double median = 0, mean = 0, stddev = 0;
+    size_t samples = 0;
+};
+
+// Outcome of comparing one cell with its baseline
+enum class Change { Unchanged, Slower, Faster };
+
+// Comparison of one cell with its baseline. Percentages are relative to the baseline mean.
+struct CellComparison {
+    BaselineRow baseline;
+    BaselineRow current;
+    double deltaPercent = 0;                // Change of the mean
+    double lowPercent = 0, highPercent = 0; // 95% confidence interval of the change
+    Change change = Change::Unchanged;
+};
+
+// Function to get the name of a change
+inline const char* toString(Change change) {
+    switch (change) {
+    case Change::Slower: return "slower";
+    case Change::Faster: return "faster";
+    default: return "unchanged";
+    }
+}
+
+// Function to convert a measured cell to a row
+inline BaselineRow toBaselineRow(const BenchmarkResult& result) {
+    return { result.algorithm, toString(result.distribution), result.size, result.seconds.median,
+        result.seconds.mean, result.seconds.stddev, result.seconds.samples };
+}
+
+// Function to read the rows of a results CSV written by Benchmark::writeCSV
+inline std::vector<BaselineRow> readBaseline(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open baseline " + filename);
+
+    // Columns are found by name, so files with or without counter columns both work
+    std::string line;
+    std::getline(file, line);
+    std::map<std::string, size_t> column;
+    {
+        std::stringstream header(line);
+        std::string name;
+        for (size_t i = 0; std::getline(header, name, ','); i++) column[name] = i;
+    }
+    for (const char* name : { "algorithm", "distribution", "size", "median", "mean", "stddev", "repetitions" }) {
+        if (column.count(name) == 0) throw std::runtime_error(filename + " has no " + name + " column");
+    }
+
+    std::vector<BaselineRow> rows;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        // The algorithm name is quoted and may contain commas; the other fields are plain
+        std::vector<std::string> fields;
+        for (size_t i = 0; i <= line.size();) {
+            if (i < line.size() && line[i] == '"') {
+                size_t end = line.find('"', i + 1);
+                fields.push_back(line.substr(i + 1, end - i - 1));
+                i = end + 2;
+            }
+            else {
+                size_t end = line.find(',', i);
+                if (end == std::string::npos) end = line.size();
+                fields.push_back(line.substr(i, end - i));
+                i = end + 1;
+            }
+        }
+        auto field = [&](const char* name) -> const std::string& {
+            size_t i = column[name];
+            if (i >= fields.size()) throw std::runtime_error("Malformed row in " + filename + ": " + line);
+            return fields[i];
+        };
+
+        BaselineRow row;
+        row.algorithm = field("algorithm");
+        row.distribution = field("distribution");
+        row.size = std::stoull(field("size"));
+        row.median = std::stod(field("median"));
+        row.mean = std::stod(field("mean"));
+        row.stddev = std::stod(field("stddev"));
+        row.samples = std::stoull(field("repetitions"));
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+// Function to get the 97.5th percentile of Student's t distribution with df degrees of freedom,
+// the critical value of a two-sided 95% interval
+inline double studentT975(double df) {
+    static const double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    if (!(df >= 1)) return table[0];
+    if (df <= 30) return table[static_cast<size_t>(df) - 1];
+    // Beyond the table t approaches the normal 1.960 like 1 / df
+    return 1.960 + (2.042 - 1.960) * 30 / df;
+}
+
+// Function to compare one cell with its baseline
+inline CellComparison compareCells(const BaselineRow& baseline, const BaselineRow& current, double tolerancePercent) {
+    CellComparison comparison{ baseline, current };
+    if (baseline.mean <= 0) return comparison;
+
+    // Welch's t-test on the difference of the means
+    double difference = current.mean - baseline.mean;
+    double nb = static_cast<double>(std::max<size_t>(baseline.samples, 1));
+    double nc = static_cast<double>(std::max<size_t>(current.samples, 1));
+    double vb = baseline.stddev * baseline.stddev / nb;
+    double vc = current.stddev * current.stddev / nc;
+    double se = std::sqrt(vb + vc);
+    double df = nb > 1 && nc > 1 && se > 0 ? (vb + vc) * (vb + vc) / (vb * vb / (nb - 1) + vc * vc / (nc - 1)) : 1;
+    double margin = studentT975(df) * se;
+
+    comparison.deltaPercent = 100 * difference / baseline.mean;
+    comparison.lowPercent = 100 * (difference - margin) / baseline.mean;
+    comparison.highPercent = 100 * (difference + margin) / baseline.mean;
+    if (comparison.lowPercent > 0 && comparison.deltaPercent > tolerancePercent) comparison.change = Change::Slower;
+    else if (comparison.highPercent < 0 && -comparison.deltaPercent > tolerancePercent) comparison.change = Change::Faster;
+    return comparison;
+}
+
+// Comparison of a run with its baseline: the cells present in both runs, and the baseline cells
+// the run did not measure
+struct RunComparison {
+    std::vector<CellComparison> cells;
+    std::vector<BaselineRow> unmatched;
+};
+
+// Function to compare every cell present in both runs, in the order of the current run
+inline RunComparison compareRuns(const std::vector<BaselineRow>& baseline,
+    const std::vector<BaselineRow>& current, double tolerancePercent) {
+    using Cell = std::tuple<std::string, std::string, size_t>;
+    std::map<Cell, const BaselineRow*> byCell;
+    for (const BaselineRow& row : baseline) byCell[{ row.algorithm, row.distribution, row.size }] = &row;
+
+    RunComparison comparison;
+    std::map<Cell, bool> matched;
+    for (const BaselineRow& row : current) {
+        auto match = byCell.find({ row.algorithm, row.distribution, row.size });
+        if (match == byCell.end()) continue;
+        comparison.cells.push_back(compareCells(*match->second, row, tolerancePercent));
+        matched[match->first] = true;
+    }
+    for (const BaselineRow& row : baseline) {
+        if (matched.count({ row.algorithm, row.distribution, row.size }) == 0) comparison.unmatched.push_back(row);
+    }
+    return comparison;
+}
+
+// Function to write the verdict of a comparison as JSON. Returns true if at least one cell was
+// compared and nothing got slower.
+inline bool writeVerdict(const std::string& filename, const std::string& label, double tolerancePercent,
+    const RunComparison& comparison) {
+    const std::vector<CellComparison>& comparisons = comparison.cells;
+    size_t slower = 0, faster = 0;
+    for (const CellComparison& c : comparisons) {
+        if (c.change == Change::Slower) slower++;
+        if (c.change == Change::Faster) faster++;
+    }
+    bool pass = !comparisons.empty() && slower == 0;
+
+    std::ofstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    file << "{\n  \"baseline\": \"" << label << "\",\n  \"verdict\": \"" << (pass ? "pass" : "fail")
+        << "\",\n  \"tolerance_percent\": " << tolerancePercent << ",\n  \"compared\": " << comparisons.size()
+        << ",\n  \"unmatched\": " << comparison.unmatched.size()
+        << ",\n  \"regressions\": " << slower << ",\n  \"improvements\": " << faster << ",\n  \"results\": [";
+    for (size_t i = 0; i < comparisons.size(); i++) {
+        const CellComparison& c = comparisons[i];
+        file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << c.current.algorithm
+            << "\", \"distribution\": \"" << c.current.distribution << "\", \"size\": " << c.current.size
+            << ", \"baseline_mean\": " << c.baseline.mean << ", \"mean\": " << c.current.mean
+            << ", \"delta_percent\": " << c.deltaPercent << ", \"ci_low_percent\": " << c.lowPercent
+            << ", \"ci_high_percent\": " << c.highPercent << ", \"change\": \"" << toString(c.change) << "\"}";
+    }
+    file << (comparisons.empty() ? "" : "\n  ") << "],\n  \"unmatched_cells\": [";
+    for (size_t i = 0; i < comparison.unmatched.size(); i++) {
+        const BaselineRow& row = comparison.unmatched[i];
+        file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << row.algorithm
+            << "\", \"distribution\": \"" << row.distribution << "\", \"size\": " << row.size
+            << ", \"baseline_mean\": " << row.mean << "}";
+    }
+    file << (comparison.unmatched.empty() ? "" : "\n  ") << "]\n}\n";
+    return pass;
+}
@@ -0,0 +1,314 @@
+/*
+    Benchmark harness for the sorting algorithms:
+    - Inputs come from a fixed seed, so every algorithm sorts exactly the same arrays and runs
+      are reproducible. Available distributions: random, sorted, reversed, few-unique,
+      organ-pipe, sawtooth, zipf and nearly-sorted (a sorted array with k random swaps).
+    - Every (algorithm, distribution, size) cell is run a few times untimed to warm up caches
+      and the allocator, then timed N times on fresh copies of the input. The report keeps the
+      median, 5th/95th percentiles, mean, standard deviation, min and max of the samples.
+    - Optionally, hardware performance counters (cycles, instructions, cache and branch misses)
+      are read around every timed run and reported as the median per cell. Where the PMU is
+      not accessible the counter columns stay empty.
+    - Results are written as CSV (one row per cell) or JSON, both readable by plot.py.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "PerfCounters.cpp" // Hardware counters around the timed runs
+
+// Shapes of input the algorithms are measured on
+enum class Distribution { Random, Sorted, Reversed, FewUnique, OrganPipe, Sawtooth, Zipf, NearlySorted };
+
+// Number of distinct keys in the few-unique distribution
+constexpr uint64_t FEW_UNIQUE_KEYS = 16;
+// Number of ascending runs in the sawtooth distribution
+constexpr size_t SAWTOOTH_TEETH = 16;
+// Number of distinct keys drawn by the Zipf distribution (rank r has probability ~ 1/r)
+constexpr size_t ZIPF_KEYS = 1 << 16;
+
+// All distributions with their names on the command line and in the reports
+inline const std::vector<std::pair<Distribution, std::string>>& distributionNames() {
+    static const std::vector<std::pair<Distribution, std::string>> names = {
+        { Distribution::Random, "random" },
+        { Distribution::Sorted, "sorted" },
+        { Distribution::Reversed, "reversed" },
+        { Distribution::FewUnique, "few-unique" },
+        { Distribution::OrganPipe, "organ-pipe" },
+        { Distribution::Sawtooth, "sawtooth" },
+        { Distribution::Zipf, "zipf" },
+        { Distribution::NearlySorted, "nearly-sorted" }
+    };
+    return names;
+}
+
+// Function to get the name of a distribution
+inline std::string toString(Distribution distribution) {
+    for (const auto& entry : distributionNames()) {
+        if (entry.first == distribution) return entry.second;
+    }
+    return "unknown";
+}
+
+// Function to parse the name of a distribution
+inline Distribution parseDistribution(const std::string& name) {
+    for (const auto& entry : distributionNames()) {
+        if (entry.second == name) return entry.first;
+    }
+    throw std::invalid_argument("Unknown distribution: " + name);
+}
+
+// Template function to generate n keys following the given distribution.
+// `swaps` is the number of random swaps applied to the nearly-sorted distribution.
+template <typename T>
+std::vector<T> generateInput(Distribution distribution, size_t n, std::mt19937_64& rng, size_t swaps) {
+    std::vector<uint64_t> keys(n);
+    switch (distribution) {
+    case Distribution::Random:
+        for (size_t i = 0; i < n; i++) keys[i] = rng() >> 33; // Fits any signed 32-bit type
+        break;
+    case Distribution::Sorted:
+        for (size_t i = 0; i < n; i++) keys[i] = i;
+        break;
+    case Distribution::Reversed:
+        for (size_t i = 0; i < n; i++) keys[i] = n - i;
+        break;
+    case Distribution::FewUnique:
+        for (size_t i = 0; i < n; i++) keys[i] = rng() % FEW_UNIQUE_KEYS;
+        break;
+    case Distribution::OrganPipe:
+        // Ascending up to the middle, then descending
+        for (size_t i = 0; i < n; i++) keys[i] = i < n / 2 ? i : n - i;
+        break;
+    case Distribution::Sawtooth: {
+        size_t period = n / SAWTOOTH_TEETH + 1;
+        for (size_t i = 0; i < n; i++) keys[i] = i % period;
+        break;
+    }
+    case Distribution::Zipf: {
+        // Inverse transform sampling over the cumulative distribution of the ranks
+        std::vector<double> cdf(ZIPF_KEYS);
+        double sum = 0;
+        for (size_t r = 0; r < ZIPF_KEYS; r++) {
+            sum += 1.0 / (r + 1);
+            cdf[r] = sum;
+        }
+        std::uniform_real_distribution<double> uniform(0, sum);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        }
+        break;
+    }
+    case Distribution::NearlySorted:
+        for (size_t i = 0; i < n; i++) keys[i] = i;
+        for (size_t k = 0; n > 1 && k < swaps; k++) {
+            std::swap(keys[rng() % n], keys[rng() % n]);
+        }
+        break;
+    }
+
+    std::vector<T> input;
+    input.reserve(n);
+    for (uint64_t key : keys) {
+        input.push_back(static_cast<T>(key));
+    }
+    return input;
+}
+
+// Summary of repeated measurements
+struct Statistics {
+    double median = 0, p5 = 0, p95 = 0; // Percentiles
+    double mean = 0, stddev = 0;        // Sample mean and standard deviation
+    double min = 0, max = 0;            // Extremes
+    size_t samples = 0;                 // Number of measurements
+};
+
+// Function to compute the p-th percentile (0..100) of sorted samples with linear interpolation
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    double rank = p / 100 * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(rank);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// Function to summarize a set of measurements
+inline Statistics summarize(std::vector<double> samples) {
+    Statistics stats;
+    stats.samples = samples.size();
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+    stats.median = percentile(samples, 50);
+    stats.p5 = percentile(samples, 5);
+    stats.p95 = percentile(samples, 95);
+    stats.min = samples.front();
+    stats.max = samples.back();
+
+    for (double s : samples) stats.mean += s;
+    stats.mean /= samples.size();
+    if (samples.size() > 1) {
+        double squares = 0;
+        for (double s : samples) squares += (s - stats.mean) * (s - stats.mean);
+        stats.stddev = std::sqrt(squares / (samples.size() - 1));
+    }
+    return stats;
+}
+
+// Settings of a benchmark run
+struct BenchmarkConfig {
+    std::vector<size_t> sizes = { 1000, 10000, 100000, 1000000 };
+    std::vector<Distribution> distributions = { Distribution::Random };
+    int warmups = 1;          // Untimed runs per cell
+    int repetitions = 5;      // Timed runs per cell
+    uint64_t seed = 42;       // Seed of every input
+    size_t swaps = 0;         // Swaps of the nearly-sorted distribution (0 means n / 100)
+    bool perfCounters = false; // Read hardware performance counters around every timed run
+};
+
+// Measurements of one algorithm on one distribution and size
+struct BenchmarkResult {
+    std::string algorithm;
+    Distribution distribution;
+    size_t size;
+    Statistics seconds;
+    PerfSample counters; // Median counts per run, valid only if counters were requested and available
+};
+
+// Template class to time sorting algorithms on vectors of T
+template <typename T>
+class Benchmark {
+private:
+    BenchmarkConfig config;
+    std::vector<BenchmarkResult> measured;
+    std::unique_ptr<PerfCounters> perf; // Only set if counters were requested and are available
+
+public:
+    explicit Benchmark(BenchmarkConfig config) : config(std::move(config)) {
+        if (this->config.perfCounters) {
+            perf = std::make_unique<PerfCounters>();
+            if (!perf->available()) {
+                std::cerr << "Hardware counters unavailable (" << perf->unavailableReason()
+                    << "), reporting time only" << std::endl;
+                perf.reset();
+            }
+        }
+    }
+
+    // Generate the input of a cell. It only depends on the seed, the distribution and the size.
+    std::vector<T> input(Distribution distribution, size_t n) const {
+        std::mt19937_64 rng(config.seed ^ (n * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(distribution));
+        size_t swaps = config.swaps != 0 ? config.swaps : n / 100;
+        return generateInput<T>(distribution, n, rng, swaps);
+    }
+
+    // Time `sort` on every distribution and every size up to maxSize
+    template <typename Sort>
+    void run(const std::string& name, Sort sort, size_t maxSize = SIZE_MAX) {
+        for (Distribution distribution : config.distributions) {
+            for (size_t n : config.sizes) {
+                if (n > maxSize) continue;
+                std::vector<T> original = input(distribution, n);
+
+                std::vector<double> samples;
+                std::vector<double> counts[PERF_EVENTS];
+                for (int r = 0; r < config.warmups + config.repetitions; r++) {
+                    std::vector<T> arr = original; // Sort a fresh copy every time
+
+                    if (perf) perf->start();
+                    auto start = std::chrono::steady_clock::now();
+                    sort(arr);
+                    auto end = std::chrono::steady_clock::now();
+                    PerfSample sample = perf ? perf->stop() : PerfSample();
+
+                    if (r == 0 && !std::is_sorted(arr.begin(), arr.end())) {
+                        std::cerr << "Warning: " << name << " did not sort " << toString(distribution)
+                            << " input of size " << n << std::endl;
+                    }
+                    if (r >= config.warmups) {
+                        samples.push_back(std::chrono::duration<double>(end - start).count());
+                        for (size_t e = 0; e < PERF_EVENTS; e++) {
+                            if (sample.valid[e]) counts[e].push_back(sample.values[e]);
+                        }
+                    }
+                }
+
+                BenchmarkResult result{ name, distribution, n, summarize(samples), PerfSample() };
+                for (size_t e = 0; e < PERF_EVENTS; e++) {
+                    result.counters.valid[e] = !counts[e].empty();
+                    result.counters.values[e] = summarize(counts[e]).median;
+                }
+                measured.push_back(result);
+
+                const Statistics& s = result.seconds;
+                std::cout << name << " | " << toString(distribution) << " | n = " << n
+                    << " | median " << s.median << "s [p5 " << s.p5 << "s, p95 " << s.p95 << "s]";
+                for (size_t e = 0; e < PERF_EVENTS; e++) {
+                    if (result.counters.valid[e]) std::cout << " " << perfEventName(e) << " " << result.counters.values[e];
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    // All measurements so far
+    const std::vector<BenchmarkResult>& results() const {
+        return measured;
+    }
+
+    // Write one row per cell as CSV
+    void writeCSV(const std::string& filename) const {
+        std::ofstream file(filename);
+        file << "algorithm,distribution,size,median,p5,p95,mean,stddev,min,max,repetitions";
+        for (size_t e = 0; e < PERF_EVENTS; e++) file << ',' << perfEventName(e);
+        file << '\n';
+        for (const BenchmarkResult& r : measured) {
+            const Statistics& s = r.seconds;
+            file << '"' << r.algorithm << "\"," << toString(r.distribution) << ',' << r.size << ','
+                << s.median << ',' << s.p5 << ',' << s.p95 << ',' << s.mean << ',' << s.stddev << ','
+                << s.min << ',' << s.max << ',' << s.samples;
+            // Counters that were not measured are left empty
+            for (size_t e = 0; e < PERF_EVENTS; e++) {
+                file << ',';
+                if (r.counters.valid[e]) file << r.counters.values[e];
+            }
+            file << '\n';
+        }
+    }
+
+    // Write the configuration and every cell as JSON
+    void writeJSON(const std::string& filename) const {
+        std::ofstream file(filename);
+        file << "{\n  \"config\": {\"seed\": " << config.seed << ", \"warmups\": " << config.warmups
+            << ", \"repetitions\": " << config.repetitions << "},\n  \"results\": [";
+        for (size_t i = 0; i < measured.size(); i++) {
+            const BenchmarkResult& r = measured[i];
+            const Statistics& s = r.seconds;
+            file << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << r.algorithm
+                << "\", \"distribution\": \"" << toString(r.distribution) << "\", \"size\": " << r.size
+                << ", \"median\": " << s.median << ", \"p5\": " << s.p5 << ", \"p95\": " << s.p95
+                << ", \"mean\": " << s.mean << ", \"stddev\": " << s.stddev << ", \"min\": " << s.min
+                << ", \"max\": " << s.max << ", \"repetitions\": " << s.samples;
+            // Counters that were not measured are null
+            for (size_t e = 0; e < PERF_EVENTS; e++) {
+                file << ", \"" << perfEventName(e) << "\": ";
+                if (r.counters.valid[e]) file << r.counters.values[e];
+                else file << "null";
+            }
+            file << "}";
+        }
+        file << "\n  ]\n}\n";
+    }
+};
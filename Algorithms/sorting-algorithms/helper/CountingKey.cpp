@@ -0,0 +1,98 @@
+/*
+    Instrumented key type to count the operations a sorting algorithm performs:
+    - CountingKey<T> wraps a T and behaves like it under comparisons, copies and moves, but
+      every comparison, copy (construction or assignment), move (construction or assignment)
+      and swap found through argument-dependent lookup increments a thread-local counter.
+      std::swap called explicitly shows up as three moves.
+    - The counters are per thread, so algorithms that run on a thread pool must be counted
+      with a single thread.
+    - Exact counts are independent of the machine, so they catch algorithmic regressions
+      (an extra copy per element, a missed early exit) that timing noise would hide.
+
+    Usage:
+        resetOperationCounts();
+        sort(keys);
+        OperationCounts counts = operationCounts;
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <utility> // For std::move, std::swap
+
+// Operations performed by the current thread since the last reset
+struct OperationCounts {
+    uint64_t comparisons = 0;
+    uint64_t copies = 0;
+    uint64_t moves = 0;
+    uint64_t swaps = 0;
+};
+
+inline thread_local OperationCounts operationCounts;
+
+// Function to reset the counters of the current thread
+inline void resetOperationCounts() {
+    operationCounts = OperationCounts();
+}
+
+// Template class of a key that counts the operations performed on it
+template <typename T>
+class CountingKey {
+public:
+    T value;
+
+    CountingKey() : value() {}
+    explicit CountingKey(T value) : value(std::move(value)) {}
+    // Conversion from other arithmetic types, so that input generators can static_cast to it
+    template <typename U>
+    explicit CountingKey(U value) : value(static_cast<T>(value)) {}
+
+    CountingKey(const CountingKey& other) : value(other.value) {
+        operationCounts.copies++;
+    }
+    CountingKey(CountingKey&& other) noexcept : value(std::move(other.value)) {
+        operationCounts.moves++;
+    }
+    CountingKey& operator=(const CountingKey& other) {
+        operationCounts.copies++;
+        value = other.value;
+        return *this;
+    }
+    CountingKey& operator=(CountingKey&& other) noexcept {
+        operationCounts.moves++;
+        value = std::move(other.value);
+        return *this;
+    }
+
+    friend bool operator<(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value < b.value;
+    }
+    friend bool operator>(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value > b.value;
+    }
+    friend bool operator<=(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value <= b.value;
+    }
+    friend bool operator>=(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value >= b.value;
+    }
+    friend bool operator==(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value == b.value;
+    }
+    friend bool operator!=(const CountingKey& a, const CountingKey& b) {
+        operationCounts.comparisons++;
+        return a.value != b.value;
+    }
+
+    // Found by unqualified calls to swap; the moves inside are not counted separately
+    friend void swap(CountingKey& a, CountingKey& b) noexcept {
+        operationCounts.swaps++;
+        using std::swap;
+        swap(a.value, b.value);
+    }
+};
@@ -0,0 +1,98 @@
+/*
+    Peak memory of a region of code, as the growth of the peak resident set size (RSS):
+    - The region runs in a forked child process, so that memory freed by earlier runs and
+      kept by the allocator does not hide the memory the region needs. The child prepares
+      its input, returns free heap memory to the system, resets its RSS high-water mark
+      (writing 5 to /proc/self/clear_refs) and then runs the region. The result is how far
+      the high-water mark (VmHWM) rose above the RSS at the start of the region.
+    - If the high-water mark cannot be reset, it is compared with the RSS at the start of
+      the region anyway, which is exact as long as preparing the input peaked lower.
+    - Only available on Linux; elsewhere, or if the child fails, the result is -1.
+
+    Usage:
+        long kilobytes = measurePeakRSS([] { return makeInput(); },
+                                        [](auto& input) { ... region ... });
+*/
+
+#pragma once
+
+#include <algorithm> // For std::max
+#include <cstdio>
+#include <cstdlib>   // For std::strtol
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <malloc.h>   // For malloc_trim
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+// Function to read a field of /proc/self/status in kB (VmRSS, VmHWM), or -1. It does not
+// allocate, so that reading the RSS does not change it.
+inline long readStatusKB(const char* field) {
+    char text[8192];
+    int fd = open("/proc/self/status", O_RDONLY);
+    if (fd < 0) return -1;
+    ssize_t length = read(fd, text, sizeof(text) - 1);
+    close(fd);
+    if (length <= 0) return -1;
+    text[length] = '\0';
+
+    size_t fieldLength = std::strlen(field);
+    for (const char* line = text; line != nullptr && *line != '\0';) {
+        if (std::strncmp(line, field, fieldLength) == 0 && line[fieldLength] == ':') {
+            return std::strtol(line + fieldLength + 1, nullptr, 10);
+        }
+        line = std::strchr(line, '\n');
+        if (line != nullptr) line++;
+    }
+    return -1;
+}
+#endif
+
+// Template function to return the growth of the peak RSS, in kB, while work(input) runs on
+// the input returned by setup(), or -1 if it cannot be measured
+template <typename Setup, typename Work>
+long measurePeakRSS(Setup setup, Work work) {
+#ifdef __linux__
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    std::fflush(nullptr); // Do not print buffered output twice
+
+    pid_t child = fork();
+    if (child < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        auto input = setup();
+        malloc_trim(0);
+        if (std::FILE* clearRefs = std::fopen("/proc/self/clear_refs", "w")) {
+            std::fputs("5", clearRefs);
+            std::fclose(clearRefs);
+        }
+        long before = readStatusKB("VmRSS");
+        work(input);
+        long peak = readStatusKB("VmHWM");
+        long growth = before < 0 || peak < 0 ? -1 : std::max(peak - before, 0L);
+        ssize_t written = write(fds[1], &growth, sizeof(growth));
+        _exit(written == sizeof(growth) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    long growth = -1;
+    if (read(fds[0], &growth, sizeof(growth)) != sizeof(growth)) growth = -1;
+    close(fds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? growth : -1;
+#else
+    (void)setup;
+    (void)work;
+    return -1;
+#endif
+}
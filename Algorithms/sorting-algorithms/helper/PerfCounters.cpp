@@ -0,0 +1,147 @@
+/*
+    Hardware performance counters for timed regions, read through Linux perf_event_open:
+    - cycles, instructions, L1 data cache read misses, last-level cache misses and
+      branch mispredictions, counted in user space for the calling thread and every thread it
+      starts after the counters are opened (the workers of the pools the parallel sorts
+      create). Threads that already run when the counters are opened are not counted.
+    - Every counter is opened on its own, so a PMU that lacks one event still reports the
+      others. When the kernel refuses all of them (no PMU in a VM or container, seccomp,
+      perf_event_paranoid too high, not Linux at all) the counters are simply unavailable
+      and the caller keeps reporting wall-clock time only.
+    - If the kernel multiplexes the counters, the counts are scaled by the fraction of the
+      region during which each counter was actually running.
+
+    Usage:
+        PerfCounters counters;
+        counters.start();
+        ... timed region ...
+        PerfSample sample = counters.stop();
+*/
+
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// The events that are counted
+enum class PerfEvent { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses };
+
+// Number of events in PerfEvent
+constexpr size_t PERF_EVENTS = 5;
+
+// Function to get the column name of an event
+inline const char* perfEventName(size_t event) {
+    static const char* names[PERF_EVENTS] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+    return names[event];
+}
+
+// Counts of one timed region. valid[e] is false if event e could not be counted.
+struct PerfSample {
+    std::array<double, PERF_EVENTS> values{};
+    std::array<bool, PERF_EVENTS> valid{};
+};
+
+// Class to count hardware events over timed regions of the calling thread
+class PerfCounters {
+private:
+    std::array<int, PERF_EVENTS> fds; // One file descriptor per event, -1 if unavailable
+    std::string error;                // Why the counters are unavailable
+
+#ifdef __linux__
+    // Function to open one counter, disabled, for the calling thread and the threads it starts
+    static int open(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.inherit = 1;        // Threads started later count into this counter too
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef __linux__
+        constexpr uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        fds[size_t(PerfEvent::Cycles)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[size_t(PerfEvent::Instructions)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[size_t(PerfEvent::L1DMisses)] = open(PERF_TYPE_HW_CACHE, L1D_READ_MISS);
+        fds[size_t(PerfEvent::LLCMisses)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[size_t(PerfEvent::BranchMisses)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        if (!available()) error = std::string("perf_event_open failed: ") + std::strerror(errno);
+#else
+        error = "hardware counters are only supported on Linux";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Whether at least one event can be counted
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    // Reason the counters are unavailable (empty if they are available)
+    const std::string& unavailableReason() const {
+        return error;
+    }
+
+    // Reset and start every counter
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stop every counter and read the counts since start()
+    PerfSample stop() {
+        PerfSample sample;
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (size_t e = 0; e < PERF_EVENTS; e++) {
+            uint64_t data[3]; // value, time enabled, time running
+            if (fds[e] < 0 || read(fds[e], data, sizeof(data)) != sizeof(data)) continue;
+            // Scale up if the counter only ran for part of the region (multiplexing)
+            double scale = data[2] != 0 ? static_cast<double>(data[1]) / data[2] : 0;
+            sample.values[e] = data[0] * scale;
+            sample.valid[e] = data[2] != 0;
+        }
+#endif
+        return sample;
+    }
+};
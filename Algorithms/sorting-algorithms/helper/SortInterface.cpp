@@ -0,0 +1,93 @@
+/*
+    Common interface of the sorting algorithms:
+    - Every sort takes an iterator pair or a range (vector, deque, array, span, ...), a
+      comparator and a projection, like the std::ranges algorithms:
+          quickSort(terms, std::greater<>(), &Term::weight);
+          quickSort(arr.begin(), arr.begin() + k);
+    - The comparator and the projection are template parameters, so both are inlined into
+      the sort. Internally they are combined into a single comparator on elements,
+      ProjectedLess, which is what the helper functions of each algorithm take.
+    - Ascending order of plain numbers is recognized at compile time (isNaturalOrder), so the
+      SIMD sorting networks can still be used where they give the same result.
+    - Requires C++20 (concepts, std::identity, std::ranges). With an older standard, the first
+      error is an #error that says so.
+*/
+
+#pragma once
+
+#if __cplusplus < 202002L
+#error "The sorting algorithms require C++20: compile with -std=c++20"
+#endif
+
+#include <cstddef>
+#include <functional> // For std::invoke, std::less, std::identity
+#include <iterator>   // For std::contiguous_iterator, std::indirect_strict_weak_order
+#include <memory>     // For std::to_address
+#include <ranges>     // For std::ranges::random_access_range
+#include <utility>    // For std::move
+#include <vector>
+
+#include "../simd-sorting-network.cpp"
+
+// Ranges accepted by the sorts besides iterator pairs
+template <typename R>
+concept SortableRange = std::ranges::random_access_range<R> && std::ranges::common_range<R>;
+
+// Comparators accepted on the projected elements of It. Overloads that also take a thread
+// count require it, so that sort(v, 4) picks the thread count instead of a comparator 4.
+template <typename Compare, typename It, typename Proj = std::identity>
+concept SortComparator = std::indirect_strict_weak_order<Compare, std::projected<It, Proj>>;
+
+// Template struct of a comparator on elements that compares their projections
+template <typename Compare, typename Proj>
+struct ProjectedLess {
+    [[no_unique_address]] Compare comp;
+    [[no_unique_address]] Proj proj;
+
+    template <typename A, typename B>
+    constexpr bool operator()(const A& a, const B& b) {
+        return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+    }
+};
+
+// Template function to combine a comparator and a projection
+template <typename Compare, typename Proj>
+constexpr ProjectedLess<Compare, Proj> projectedLess(Compare comp, Proj proj) {
+    return { std::move(comp), std::move(proj) };
+}
+
+// Whether a comparator on elements is the plain ascending order
+template <typename Less>
+constexpr bool isNaturalOrder = false;
+template <typename T>
+constexpr bool isNaturalOrder<std::less<T>> = true;
+template <>
+constexpr bool isNaturalOrder<std::ranges::less> = true;
+template <typename Compare>
+constexpr bool isNaturalOrder<ProjectedLess<Compare, std::identity>> = isNaturalOrder<Compare>;
+
+// Template function to sort [first, last) with a SIMD sorting network if the elements are stored
+// contiguously and ordered naturally. Returns false if no network applies.
+template <typename RandomIt, typename Less>
+bool simdSortSmall(RandomIt first, RandomIt last, const Less&) {
+    if constexpr (isNaturalOrder<Less> && std::contiguous_iterator<RandomIt>) {
+        return simdSortSmall(std::to_address(first), static_cast<size_t>(last - first));
+    }
+    else {
+        return false;
+    }
+}
+
+// Template function to call sort(T* data, size_t n) on [first, last). Elements that are not
+// stored contiguously (a deque, say) are moved to a temporary array and back.
+template <typename RandomIt, typename Sort>
+void sortContiguous(RandomIt first, RandomIt last, Sort sort) {
+    if constexpr (std::contiguous_iterator<RandomIt>) {
+        sort(std::to_address(first), static_cast<size_t>(last - first));
+    }
+    else {
+        std::vector<std::iter_value_t<RandomIt>> temp(std::make_move_iterator(first), std::make_move_iterator(last));
+        sort(temp.data(), temp.size());
+        std::move(temp.begin(), temp.end(), first);
+    }
+}
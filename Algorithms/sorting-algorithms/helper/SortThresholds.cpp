@@ -0,0 +1,28 @@
+/*
+    Thresholds of autoSort (auto-sort.cpp). These are neutral defaults, not measurements:
+    run `analyze --calibrate` on the target machine and copy the file it writes over
+    helper/SortThresholds.cpp.
+
+    Sample Sort is only picked where std::thread::hardware_concurrency() reports more than one
+    thread, so the parallel threshold is safe on single-core machines too.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Arrays up to this size are insertion sorted
+constexpr size_t AUTO_SORT_INSERTION_MAX = 32;
+
+// Arithmetic keys in ascending order are radix sorted from this size on
+constexpr size_t AUTO_SORT_RADIX_MIN = 1024;
+
+// Sample Sort on all hardware threads from this size on (SIZE_MAX: never)
+constexpr size_t AUTO_SORT_PARALLEL_MIN = 1 << 17;
+
+// Adaptive Merge Sort when at most this fraction of neighbours ends a run
+constexpr double AUTO_SORT_PRESORTED_MAX_RUN_BREAKS = 0.1;
+
+// 3-way Quick Sort when at least this fraction of sampled neighbours are duplicates (above 1: never)
+constexpr double AUTO_SORT_DUPLICATES_MIN = 0.5;
@@ -8,42 +8,49 @@
 #include <chrono>
 #include <functional>
 
+#include "Benchmark.cpp" // Input distributions and statistics
+
 // Template class Test to measure sorting algorithm performance
 template <typename T>
 class Test {
 private:
-    // Function to generate a random array of size n
-    std::vector<T> generateRandomArray(int n) {
-        std::vector<T> arr(n);
-        std::mt19937 rng(std::time(nullptr)); // Random number generator seeded with current time
-        for (int i = 0; i < n; ++i) {
-            arr[i] = rng(); // Generate random numbers
-        }
-        return arr;
-    }
+    int repetitions; // Number of timed runs
+    uint64_t seed;   // Seed of the generated arrays, fixed so that runs can be compared
 
 public:
-    // Overloaded operator() to perform the test
-    double operator()(void (*sortingAlgo)(std::vector<T>&), int n) {
-        // Generate a random array of size n
-        std::vector<T> arr = generateRandomArray(n);
+    Test(int repetitions = 5, uint64_t seed = 42) : repetitions(repetitions), seed(seed) {}
 
-        // Get the current time before sorting
-        auto start = std::chrono::high_resolution_clock::now();
+    // Overloaded operator() to perform the test. Any callable taking a std::vector<T>& works;
+    // lambdas are inlined into the timing loop, function pointers are called indirectly.
+    template <typename Sort>
+    double operator()(Sort sortingAlgo, int n, Distribution distribution = Distribution::Random) {
+        // Generate an array of size n
+        std::mt19937_64 rng(seed);
+        std::vector<T> original = generateInput<T>(distribution, n, rng, n / 100);
 
-        // Perform the sorting using the given sorting algorithm
-        sortingAlgo(arr);
+        std::vector<double> samples;
+        for (int r = 0; r < repetitions; r++) {
+            std::vector<T> arr = original;
 
-        // Get the current time after sorting
-        auto end = std::chrono::high_resolution_clock::now();
+            // Get the current time before sorting
+            auto start = std::chrono::steady_clock::now();
 
-        // Calculate the duration of the sort
-        std::chrono::duration<double> duration = end - start;
+            // Perform the sorting using the given sorting algorithm
+            sortingAlgo(arr);
+
+            // Get the current time after sorting
+            auto end = std::chrono::steady_clock::now();
+
+            // Store the duration of the sort
+            samples.push_back(std::chrono::duration<double>(end - start).count());
+        }
 
-        // Print the duration of the sort
-        std::cout << "Time taken to sort " << n << " elements: " << duration.count() << "s" << std::endl;
+        // Print the summary of the durations
+        Statistics stats = summarize(samples);
+        std::cout << "Time taken to sort " << n << " elements: median " << stats.median << "s (p5 "
+            << stats.p5 << "s, p95 " << stats.p95 << "s, " << repetitions << " runs)" << std::endl;
 
-        return duration.count();  // Return the duration if needed
+        return stats.median;  // Return the median duration if needed
     }
 
-};
\ No newline at end of file
+};
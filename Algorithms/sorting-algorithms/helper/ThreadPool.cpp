@@ -0,0 +1,155 @@
+/*
+    Work-Stealing Thread Pool:
+    - Every thread owns a deque of tasks. A thread pushes and pops its own tasks at the back
+      (LIFO, so the data it just touched is still in cache) and, when its deque runs dry, steals
+      from the front of another thread's deque (FIFO, so thieves take the biggest pending pieces).
+    - Fork-join is expressed with a TaskGroup: spawn() forks a task into the group and wait()
+      joins it. A thread that waits keeps running pending tasks instead of blocking, so recursive
+      divide-and-conquer algorithms can spawn from inside tasks without deadlocking the pool.
+    - The thread calling wait() takes part in the work, so a pool of size n starts n - 1 workers.
+
+    Tasks must not throw.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // Set of tasks that can be joined together
+    class TaskGroup {
+        friend class ThreadPool;
+        std::atomic<size_t> pending{ 0 }; // Number of spawned tasks that have not finished yet
+    };
+
+    // Create a pool that runs tasks on `threads` threads (the waiting caller included)
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        // Queue 0 is shared by all threads outside the pool
+        for (unsigned i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    // Stop the workers. Every group must have been waited on before this point.
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that execute tasks, including the waiting caller
+    unsigned size() const {
+        return static_cast<unsigned>(queues.size());
+    }
+
+    // Fork a task into the group
+    template <typename F>
+    void spawn(TaskGroup& group, F&& task) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        queued.fetch_add(1, std::memory_order_release);
+        Queue& queue = *queues[ownQueue()];
+        {
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.emplace_back([&group, task = std::forward<F>(task)]() mutable {
+                task();
+                group.pending.fetch_sub(1, std::memory_order_release);
+                });
+        }
+        // Taking the lock orders this notification after a sleeper's predicate check
+        { std::lock_guard<std::mutex> guard(sleepLock); }
+        wakeUp.notify_one();
+    }
+
+    // Join the group, running pending tasks while its children are still in flight
+    void wait(TaskGroup& group) {
+        size_t self = ownQueue();
+        while (group.pending.load(std::memory_order_acquire) != 0) {
+            if (!runOne(self)) std::this_thread::yield();
+        }
+    }
+
+private:
+    // A task deque guarded by its own lock
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; // One deque per thread
+    std::vector<std::thread> workers;           // Threads owned by the pool
+    std::atomic<size_t> queued{ 0 };            // Tasks pushed but not yet taken
+    bool stopping = false;                      // Set once by the destructor
+    std::mutex sleepLock;                       // Guards idle workers going to sleep
+    std::condition_variable wakeUp;             // Signalled when a task is pushed
+
+    // Pool and queue index of the current thread (queue 0 if it is not a worker)
+    inline static thread_local ThreadPool* currentPool = nullptr;
+    inline static thread_local size_t currentQueue = 0;
+
+    // Index of the deque owned by the calling thread
+    size_t ownQueue() const {
+        return currentPool == this ? currentQueue : 0;
+    }
+
+    // Pop a task from our own deque or steal one from another deque, then run it
+    bool runOne(size_t self) {
+        std::function<void()> task;
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        // Steal from the other deques, starting after our own
+        for (size_t k = 1; !task && k < queues.size(); ++k) {
+            Queue& victim = *queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    // Body of every worker: run tasks, sleep while there are none
+    void workerLoop(size_t index) {
+        currentPool = this;
+        currentQueue = index;
+        while (true) {
+            if (runOne(index)) continue;
+
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wakeUp.wait(guard, [this] {
+                return stopping || queued.load(std::memory_order_acquire) != 0;
+                });
+            if (stopping) return;
+        }
+    }
+};
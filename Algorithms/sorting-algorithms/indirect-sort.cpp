@@ -0,0 +1,182 @@
+/*
+    Indirect Sort:
+    - For large elements (records of a few hundred bytes, strings), the sorts spend most of
+      their time moving whole elements around. An indirect sort orders a compact array that
+      refers to the elements instead, and moves every element only once at the end.
+    - argsort returns the permutation that sorts the elements, without moving them:
+      first[perm[0]], first[perm[1]], ... is sorted.
+    - applyPermutation rearranges the elements by a permutation in one pass, following its
+      cycles: every element is moved once, plus one extra move per cycle.
+    - indirectSort combines both.
+
+    Key prefixes:
+    - If the key has a prefix, an unsigned 64-bit integer with prefix(a) < prefix(b) only when
+      a comes before b, the permutation is built from (prefix, index) pairs. The pairs are
+      16 bytes wide and radix sorted, and only runs of pairs with equal prefixes are compared
+      on the full keys.
+    - KeyPrefix gives prefixes for numbers (exact for integers) and for strings (their first
+      8 bytes). Other key types, or comparators other than ascending order, fall back to
+      comparing through the indices, unless a prefix function is passed.
+    - Floating point prefixes map -0.0 to 0.0, so equal zeros keep their input order too.
+
+    Time Complexity:
+    - With an exact prefix: O(n) for the radix sort plus O(n) moves.
+    - Otherwise: O(n log n) comparisons, O(n) moves of elements.
+
+    Space Complexity: O(n) - Indices (and prefixes), not elements.
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <numeric>     // For std::iota
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <functional>  // For std::invoke, std::identity
+#include <utility>     // For std::move
+
+#include "merge-sort.cpp" // Sorts the indices
+#include "radix-sort.cpp" // Sorts the (prefix, index) pairs
+#include "helper/SortInterface.cpp"
+
+// Default prefixes of keys: numbers and strings
+struct KeyPrefix {
+    // Numbers, mapped to unsigned integers of the same order and aligned to the top bits.
+    // -0.0 becomes 0.0 first: the two compare equal, so they must share a prefix to stay in
+    // input order.
+    template <typename K> requires std::is_arithmetic_v<K>
+    uint64_t operator()(K key) const {
+        if constexpr (std::is_floating_point_v<K>) {
+            if (key == 0) key = 0;
+        }
+        return static_cast<uint64_t>(toRadixKey(key)) << (64 - 8 * sizeof(K));
+    }
+
+    // The first 8 bytes of a string, big-endian so that the prefixes compare like the strings
+    uint64_t operator()(std::string_view key) const {
+        uint64_t prefix = 0;
+        for (size_t i = 0; i < 8; i++) {
+            unsigned char c = i < key.size() ? static_cast<unsigned char>(key[i]) : 0;
+            prefix = (prefix << 8) | c;
+        }
+        return prefix;
+    }
+    uint64_t operator()(const std::string& key) const {
+        return (*this)(std::string_view(key));
+    }
+};
+
+// Whether equal KeyPrefix prefixes imply equal keys of type K
+template <typename Prefix, typename K>
+constexpr bool isExactPrefix = std::is_same_v<Prefix, KeyPrefix> && std::is_integral_v<K>;
+
+// A prefix of the key of an element and the position of the element
+struct PrefixIndex {
+    uint64_t prefix;
+    size_t index;
+};
+
+// Template function to rearrange [first, last) so that the element at i is the one that was at
+// perm[i]. perm must be a permutation of 0..n-1.
+template <std::random_access_iterator RandomIt>
+void applyPermutation(RandomIt first, RandomIt last, std::vector<size_t> perm) {
+    size_t n = static_cast<size_t>(last - first);
+    if (perm.size() != n) throw std::invalid_argument("Permutation and range sizes differ");
+
+    for (size_t i = 0; i < n; i++) {
+        if (perm[i] == i) continue; // In place, or an already rotated cycle
+
+        // Rotate the cycle through i: every position takes the element it points to
+        auto value = std::move(first[i]);
+        size_t j = i;
+        while (perm[j] != i) {
+            size_t next = perm[j];
+            first[j] = std::move(first[next]);
+            perm[j] = j; // Mark as placed
+            j = next;
+        }
+        first[j] = std::move(value);
+        perm[j] = j;
+    }
+}
+
+// Template function to build the sorting permutation of [first, last) from key prefixes
+template <typename RandomIt, typename Less, typename Proj, typename Prefix>
+std::vector<size_t> argsortByPrefix(RandomIt first, RandomIt last, Less& less, Proj& proj, Prefix& prefix) {
+    using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, std::iter_reference_t<RandomIt>>>;
+    size_t n = static_cast<size_t>(last - first);
+
+    std::vector<PrefixIndex> pairs;
+    pairs.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        pairs.push_back({ static_cast<uint64_t>(std::invoke(prefix, std::invoke(proj, first[i]))), i });
+    }
+    radixSortLSD<11>(pairs, &PrefixIndex::prefix); // Stable, so equal prefixes stay in index order
+
+    std::vector<size_t> perm(n);
+    for (size_t i = 0; i < n; i++) perm[i] = pairs[i].index;
+
+    // Elements with equal prefixes are ordered by their full keys
+    if constexpr (!isExactPrefix<Prefix, Key>) {
+        auto byIndex = [&less, first](size_t a, size_t b) { return less(first[a], first[b]); };
+        std::vector<size_t> buffer;
+        for (size_t i = 0, j; i < n; i = j) {
+            for (j = i + 1; j < n && pairs[j].prefix == pairs[i].prefix; j++) {}
+            if (j - i > 1) {
+                buffer.reserve((j - i + 1) / 2);
+                mergeSortBy(perm.begin() + i, perm.begin() + j, buffer, byIndex);
+            }
+        }
+    }
+    return perm;
+}
+
+// Template function to return the permutation that sorts [first, last), without moving the
+// elements. prefix is applied to the projected keys; see KeyPrefix.
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity,
+    typename Prefix = KeyPrefix>
+std::vector<size_t> argsort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj(), Prefix prefix = Prefix()) {
+    using Key = std::invoke_result_t<Proj&, std::iter_reference_t<RandomIt>>;
+    auto less = projectedLess(comp, proj);
+
+    // KeyPrefix orders keys ascending, so it only applies to the natural order
+    constexpr bool usePrefix = std::is_invocable_v<Prefix&, Key> &&
+        (!std::is_same_v<Prefix, KeyPrefix> || isNaturalOrder<Compare>);
+    if constexpr (usePrefix) {
+        return argsortByPrefix(first, last, less, proj, prefix);
+    }
+    else {
+        std::vector<size_t> perm(static_cast<size_t>(last - first));
+        std::iota(perm.begin(), perm.end(), size_t(0));
+        auto byIndex = [&less, first](size_t a, size_t b) { return less(first[a], first[b]); };
+        std::vector<size_t> buffer;
+        buffer.reserve((perm.size() + 1) / 2);
+        mergeSortBy(perm.begin(), perm.end(), buffer, byIndex);
+        return perm;
+    }
+}
+
+// Template function to return the permutation that sorts a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity, typename Prefix = KeyPrefix>
+std::vector<size_t> argsort(Range&& range, Compare comp = Compare(), Proj proj = Proj(), Prefix prefix = Prefix()) {
+    return argsort(std::ranges::begin(range), std::ranges::end(range), comp, proj, prefix);
+}
+
+// Template function to perform Indirect Sort: sort a permutation, then move every element once
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity,
+    typename Prefix = KeyPrefix>
+void indirectSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj(), Prefix prefix = Prefix()) {
+    applyPermutation(first, last, argsort(first, last, comp, proj, prefix));
+}
+
+// Template function to perform Indirect Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity, typename Prefix = KeyPrefix>
+void indirectSort(Range&& range, Compare comp = Compare(), Proj proj = Proj(), Prefix prefix = Prefix()) {
+    indirectSort(std::ranges::begin(range), std::ranges::end(range), comp, proj, prefix);
+}
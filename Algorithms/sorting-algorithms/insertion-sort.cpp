@@ -15,23 +15,40 @@
     Stable: Yes
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <utility> // For std::move
 
-// Template function to perform Insertion Sort
-template <typename T>
-void insertionSort(std::vector<T>& arr) {
-    // Get the size of the array
-    int n = arr.size();
-    for (int i = 1; i < n; i++) {
+#include "helper/SortInterface.cpp"
+
+// Template function to perform Insertion Sort on [first, last) with a comparator on elements
+template <typename RandomIt, typename Less>
+void insertionSortBy(RandomIt first, RandomIt last, Less& less) {
+    if (first == last) return;
+    for (RandomIt i = first + 1; i != last; ++i) {
         // Store the Current element
-        T key = arr[i];
-        int j = i - 1; // Index of the previous element
-        // Move elements of arr[0..i-1] that are greater than key
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j]; // Shift the element to the right
-            j--;
+        auto key = std::move(*i);
+        RandomIt j = i; // Position of the hole
+        // Move elements of [first, i) that are greater than key
+        while (j != first && less(key, *(j - 1))) {
+            *j = std::move(*(j - 1)); // Shift the element to the right
+            --j;
         }
-        arr[j + 1] = key; // Insert the key in the correct position
+        *j = std::move(key); // Insert the key in the correct position
     }
-}
\ No newline at end of file
+}
+
+// Template function to perform Insertion Sort
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    insertionSortBy(first, last, less);
+}
+
+// Template function to perform Insertion Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void insertionSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    insertionSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -0,0 +1,173 @@
+/*
+    List Merge Sort:
+    - Merge sort of a singly linked list by relinking its nodes: no element is copied or moved
+      and no node is allocated, so it works for linked containers whose elements are expensive
+      to copy and whose nodes must stay where they are.
+    - Linked lists are bound by pointer chasing: the next node is only known once the current
+      one is loaded, so a plain merge waits for one cache miss per node and level, about 24
+      times per node for 10M nodes. This sort keeps the number of passes over scattered nodes
+      small and overlaps the misses of the passes it does:
+    1. Runs: up to LIST_SORT_RUN consecutive nodes are collected into a fixed array of node
+       pointers, sorted there with std::stable_sort (the nodes just walked are still in cache)
+       and relinked in order.
+    2. Multiway merges, bottom-up: the runs gather at level 0. Once LIST_SORT_WAYS runs are
+       there, they are merged into one with a tournament tree and the result moves up to level
+       1, and so on. The levels left at the end are merged from the bottom up.
+    - In a K-way merge, a run is taken from about once every K steps. When a node is taken,
+      the node after the new head of its run is prefetched, so that it arrives while the other
+      runs are being taken from, instead of stalling the merge when its turn comes.
+    - Only node pointers are buffered: the run array and its merge buffer, of a fixed size, and
+      one array of LIST_SORT_WAYS + 1 pointers per merge level, added as the list needs them
+      (2 levels for 10M nodes).
+    - The node type is given by a pointer to its next member and a comparator on nodes, so any
+      intrusive list can use it. Doubly linked lists also pass their prev member, whose links
+      are set during the last merge, and get their new tail back.
+    - analysis/list-sort-benchmark.cpp compares it with copying the items out into a vector,
+      sorting them and writing them back. For 2M random items (medians of 3 runs):
+        int list, nodes in list order:      0.50 s against 0.30 s (1.6 times slower)
+        int list, nodes scattered:          1.13 s against 1.22 s
+        string list, nodes in list order:   1.18 s against 1.22 s
+        string list, nodes scattered:       2.05 s against 2.28 s
+      So a Deque<int> whose nodes were allocated one after another (HW-1) sorts faster by
+      copying its items out; relinking pays off when the nodes are scattered or the items are
+      expensive to move, and when the nodes must not change their items.
+
+    Time Complexity:
+    - Best Case: O(n log n)
+    - Average Case: O(n log n)
+    - Worst Case: O(n log n)
+
+    Space Complexity: O(R + K log_K(n / R)) - Node pointers, for runs of R = LIST_SORT_RUN and
+     K = LIST_SORT_WAYS: about 50 kB for 10M nodes. No element is copied.
+    In-Place: No - The nodes are relinked where they are, but the pointers above are extra.
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <algorithm> // For std::stable_sort
+
+// Number of nodes sorted together in the pointer array
+constexpr size_t LIST_SORT_RUN = 4096;
+// Number of runs merged at once
+constexpr size_t LIST_SORT_WAYS = 64;
+
+// Template function to start loading a node before it is needed
+template <typename Node>
+inline void prefetchNode(const Node* node) {
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+#else
+    (void)node;
+#endif
+}
+
+// Template function to merge the sorted lists runs[0..count) into one, with a tournament tree.
+// On ties the node of the earlier run comes first, so runs must be in input order. If prev is
+// not null, the prev links of the result are set too. Returns the head and sets last to the
+// last node.
+template <typename Node, typename NodeLess>
+Node* mergeLists(Node** runs, size_t count, Node* Node::* next, Node* Node::* prev, NodeLess& less, Node*& last) {
+    last = nullptr;
+    if (count == 0) return nullptr;
+    size_t leaves = 1;
+    while (leaves < count) leaves *= 2;
+
+    // tree[leaves + r] is run r, tree[i] the winner of tree[2i] and tree[2i + 1]. An empty
+    // run (nullptr) loses against everything.
+    std::array<size_t, 4 * LIST_SORT_WAYS> tree;
+    std::array<Node*, 2 * LIST_SORT_WAYS> heads{};
+    for (size_t r = 0; r < count; r++) {
+        heads[r] = runs[r];
+        if (heads[r] != nullptr) prefetchNode(heads[r]->*next);
+    }
+    auto winner = [&heads, &less](size_t a, size_t b) {
+        // Take b only if it is strictly smaller, to keep the merge stable (a is the earlier run)
+        if (heads[a] == nullptr) return b;
+        if (heads[b] == nullptr) return a;
+        return less(heads[b], heads[a]) ? b : a;
+    };
+    heads[count] = nullptr; // Padding leaves point to this empty run
+    for (size_t r = 0; r < leaves; r++) tree[leaves + r] = r < count ? r : count;
+    for (size_t i = leaves - 1; i > 0; i--) tree[i] = winner(tree[2 * i], tree[2 * i + 1]);
+
+    Node* head = nullptr;
+    Node** tail = &head; // Link to fill with the next node
+    while (heads[tree[1]] != nullptr) {
+        size_t r = tree[1];
+        Node* node = heads[r];
+        *tail = node;
+        tail = &(node->*next);
+        if (prev != nullptr) node->*prev = last;
+        last = node;
+
+        // Advance run r and load the node after its new head ahead of time
+        heads[r] = node->*next;
+        if (heads[r] != nullptr) prefetchNode(heads[r]->*next);
+
+        // Replay the matches on the path of run r
+        for (size_t i = (leaves + r) / 2; i > 0; i /= 2) tree[i] = winner(tree[2 * i], tree[2 * i + 1]);
+    }
+    *tail = nullptr;
+    return head;
+}
+
+// Template function to sort the list starting at head by relinking its nodes. Returns the new
+// head; the last node links to nullptr. For doubly linked lists, prev is their prev member:
+// the prev links are rebuilt during the last merge and tail is set to the last node, which
+// saves another walk over the scattered nodes.
+template <typename Node, typename NodeLess>
+Node* listMergeSort(Node* head, Node* Node::* next, NodeLess less, Node* Node::* prev = nullptr, Node** tail = nullptr) {
+    // Runs waiting at every level, in input order. One more than LIST_SORT_WAYS, for the final
+    // merge with the result of the levels below.
+    std::vector<std::array<Node*, LIST_SORT_WAYS + 1>> levels;
+    std::vector<size_t> counts;
+
+    auto nodeLess = [&less](Node* a, Node* b) { return less(a, b); };
+    std::vector<Node*> run;
+    Node* last = nullptr;
+    run.reserve(LIST_SORT_RUN);
+
+    while (head != nullptr) {
+        // Collect and sort the next run
+        run.clear();
+        while (head != nullptr && run.size() < LIST_SORT_RUN) {
+            run.push_back(head);
+            head = head->*next;
+            if (head != nullptr) prefetchNode(head->*next);
+        }
+        std::stable_sort(run.begin(), run.end(), nodeLess);
+        for (size_t i = 0; i + 1 < run.size(); i++) run[i]->*next = run[i + 1];
+        run.back()->*next = nullptr;
+
+        // Add it to level 0, merging full levels upwards
+        Node* list = run.front();
+        size_t level = 0;
+        while (true) {
+            if (level == levels.size()) {
+                levels.emplace_back();
+                counts.push_back(0);
+            }
+            levels[level][counts[level]++] = list;
+            if (counts[level] < LIST_SORT_WAYS) break;
+            list = mergeLists(levels[level].data(), counts[level], next, prev, less, last);
+            counts[level] = 0;
+            level++;
+        }
+    }
+
+    // Merge what is left, from the bottom up. The lower levels hold the later nodes. The last
+    // merge walks every node, even if it only has one list.
+    Node* sorted = nullptr;
+    for (size_t level = 0; level < levels.size(); level++) {
+        if (counts[level] == 0) continue;
+        if (sorted != nullptr) levels[level][counts[level]++] = sorted;
+        sorted = mergeLists(levels[level].data(), counts[level], next, prev, less, last);
+    }
+    if (tail != nullptr) *tail = last;
+    return sorted;
+}
@@ -2,7 +2,10 @@
     Merge Sort:
     - Merge Sort is a Divide and Conquer algorithm.
     - It recursively divides the array into two halves until each sub-array contains only one element.
-    - It then merges the sub-arrays in a sorted order.
+    - It then merges the sub-arrays in a sorted order. Only the left half is moved out to a
+      buffer, allocated once for the whole sort, and merged back with the right half in place.
+    - Small sub-arrays are sorted directly with a sorting network for integers in ascending or
+      descending order (SIMD for ascending), or with insertion sort otherwise.
 
     Time Complexity:
     - Best Case: O(n log n) - When the array is already sorted.
@@ -14,60 +17,78 @@
     Stable: Yes
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <iterator> // For std::iter_value_t
+#include <utility>  // For std::move
+
+#include "insertion-sort.cpp"        // Used for small sub-arrays
+#include "sorting-network.cpp"      // Used for small sub-arrays of integer keys
+#include "helper/SortInterface.cpp"
+
+// Sub-arrays up to this size are sorted without recursing
+constexpr int MERGESORT_CUTOFF = 16;
+
+// Template Function to merge the sorted ranges [first, mid) and [mid, last)
+template <typename RandomIt, typename T, typename Less>
+void merge(RandomIt first, RandomIt mid, RandomIt last, std::vector<T>& buffer, Less& less) {
+    // Move the left half out of the way
+    buffer.clear();
+    for (RandomIt it = first; it != mid; ++it) {
+        buffer.push_back(std::move(*it));
+    }
 
-// Template Function to merge two sub-arrays
-template <typename T>
-void merge(std::vector<T>& arr, int left, int mid, int right) {
-    int n = right - left + 1; // Total number of elements to merge
-    std::vector<T> temp(n);      // Single auxiliary array
-    int i = left;             // Starting index for the left half
-    int j = mid + 1;          // Starting index for the right half
-    int k = 0;                // Index for temp array
+    auto i = buffer.begin(); // Next element of the left half
+    RandomIt j = mid;        // Next element of the right half
+    RandomIt k = first;      // Next output position, never past j
 
-    // Merge the two halves into the temp array
-    while (i <= mid && j <= right) {
-        if (arr[i] <= arr[j]) {
-            temp[k++] = arr[i++];
+    // Merge the two halves back into the array
+    while (i != buffer.end() && j != last) {
+        // Take from the right half only if it is strictly smaller, to keep the merge stable
+        if (less(*j, *i)) {
+            *k++ = std::move(*j++);
         }
         else {
-            temp[k++] = arr[j++];
+            *k++ = std::move(*i++);
         }
     }
 
-    // Copy remaining elements of the left half, if any
-    while (i <= mid) {
-        temp[k++] = arr[i++];
-    }
-
-    // Copy remaining elements of the right half, if any
-    while (j <= right) {
-        temp[k++] = arr[j++];
-    }
+    // Move remaining elements of the left half, if any. The rest of the right half is in place.
+    std::move(i, buffer.end(), k);
+}
 
-    // Copy the merged elements back into the original array
-    for (int p = 0; p < n; p++) {
-        arr[left + p] = temp[p];
+// Template function to perform Merge Sort on [first, last) with a comparator on elements
+template <typename RandomIt, typename T, typename Less>
+void mergeSortBy(RandomIt first, RandomIt last, std::vector<T>& buffer, Less& less) {
+    // Sort small sub-arrays directly. Networks are not stable, but they only take plain
+    // integers in ascending or descending order, for which that cannot be observed.
+    if (last - first <= MERGESORT_CUTOFF) {
+        if (!sortSmall(first, last, less)) {
+            insertionSortBy(first, last, less);
+        }
+        return;
     }
-}
 
+    RandomIt mid = first + (last - first) / 2; // Calculate the middle
 
+    mergeSortBy(first, mid, buffer, less); // Sort the left half
+    mergeSortBy(mid, last, buffer, less); // Sort the right half
+    merge(first, mid, last, buffer, less); // Merge the sorted halves
+}
 
 // Template function to perform Merge Sort
-template <typename T>
-void mergeSort(std::vector<T>& arr, int left, int right) {
-    if (left >= right) return;
-
-    int mid = left + (right - left) / 2; // Calculate the middle index
-
-    mergeSort(arr, left, mid); // Sort the left half
-    mergeSort(arr, mid + 1, right); // Sort the right half
-    merge(arr, left, mid, right); // Merge the sorted halves
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    std::vector<std::iter_value_t<RandomIt>> buffer;
+    buffer.reserve((last - first + 1) / 2); // Large enough for every left half
+    mergeSortBy(first, last, buffer, less);
 }
 
-// Template function to perform Merge Sort
-template <typename T>
-void mergeSort(std::vector<T>& arr) {
-    mergeSort<T>(arr, 0, arr.size() - 1);
+// Template function to perform Merge Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void mergeSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    mergeSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
 }
@@ -0,0 +1,310 @@
+/*
+    Normalized Key Sort:
+    - Sorting records by several fields usually means a chain of comparators, called through
+      std::function or a lambda per field, for every one of the n log n comparisons. Such a
+      comparator cannot drive a radix sort either.
+    - A normalized key is the sort key of a record encoded as a byte string whose memcmp order
+      is the order of the records, as database engines do. The fields are encoded one after
+      the other:
+      - numbers: toRadixKey (see radix-sort.cpp), big-endian, in sizeof(K) bytes. Signed
+        integers have their sign bit flipped, floats their sign bit or all bits, so that
+        -0.0 comes before 0.0 and NaNs go to the ends.
+      - strings: every byte as is, except '\0', written as 0x00 0xFF, then the terminator
+        0x00 0x00. A string sorts before every string it is a prefix of, and the terminator
+        keeps the next field from being compared with the tail of a longer string.
+      - string prefixes: the first PrefixBytes bytes, padded with '\0', in a fixed width.
+        Records with equal prefixes are ordered by the full fields afterwards. Fields after a
+        prefix are left out of the bytes, as they would be compared against unrelated tails.
+      - descending fields have every byte of their encoding inverted.
+    - Sorting then only looks at bytes. The first 8 bytes of every key are packed into an
+      integer and radix sorted with the position of the record, as in indirect-sort.cpp. Keys
+      of up to 8 bytes (an int and a float, a 64-bit weight, a 4-byte string prefix and an
+      int) are then sorted. Runs of longer keys with equal first 8 bytes are merge sorted on
+      the rest of their bytes.
+    - The elements are moved once at the end (applyPermutation).
+
+    Time Complexity:
+    - Keys of up to 8 bytes: O(n) for the radix sort, plus comparisons of records with equal
+      string prefixes.
+    - Otherwise: O(n) for the radix sort, plus O(m log m) byte string comparisons for every
+      run of m keys that share their first 8 bytes.
+
+    Space Complexity: O(n) - The keys and one (prefix, index) pair per record.
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>  // For std::min
+#include <concepts>   // For std::convertible_to
+#include <cstdint>
+#include <functional> // For std::invoke
+#include <tuple>
+#include <type_traits>
+#include <utility>    // For std::move
+
+#include "radix-sort.cpp"    // toRadixKey, and the sort of key prefixes
+#include "merge-sort.cpp"    // Orders records with equal key prefixes
+#include "indirect-sort.cpp" // PrefixIndex, and applyPermutation moves the elements
+#include "helper/SortInterface.cpp"
+
+// Order of one field of a normalized key
+enum class KeyOrder { Ascending, Descending };
+
+// Field of a normalized key: a projection to a number or a string, and its order. A string
+// field with PrefixBytes > 0 only encodes that many bytes.
+template <typename Proj, size_t PrefixBytes = 0>
+struct KeyField {
+    Proj proj;
+    KeyOrder order = KeyOrder::Ascending;
+
+    // Width of the encoding for elements of type T, 0 if it depends on the element
+    template <typename T>
+    static constexpr size_t width() {
+        using Key = std::remove_cvref_t<std::invoke_result_t<const Proj&, const T&>>;
+        if constexpr (std::is_arithmetic_v<Key>) return sizeof(Key);
+        else return PrefixBytes;
+    }
+
+    // Whether the encoding stops at a prefix of the field
+    static constexpr bool truncated = PrefixBytes > 0;
+
+    // Append the encoding of the field of element to out
+    template <typename T>
+    void encode(const T& element, std::string& out) const {
+        using Key = std::remove_cvref_t<std::invoke_result_t<const Proj&, const T&>>;
+        unsigned char flip = order == KeyOrder::Descending ? 0xFF : 0x00;
+        decltype(auto) key = std::invoke(proj, element);
+
+        if constexpr (std::is_arithmetic_v<Key>) {
+            uint64_t bits = static_cast<uint64_t>(toRadixKey(key));
+            char encoded[sizeof(Key)];
+            for (size_t i = 0; i < sizeof(Key); i++) {
+                encoded[i] = static_cast<char>(static_cast<unsigned char>(bits >> (8 * (sizeof(Key) - 1 - i))) ^ flip);
+            }
+            out.append(encoded, sizeof(Key));
+        }
+        else {
+            static_assert(std::is_convertible_v<Key, std::string_view>, "Key fields must be numbers or strings");
+            std::string_view chars = key;
+            if constexpr (PrefixBytes > 0) {
+                for (size_t i = 0; i < PrefixBytes; i++) {
+                    unsigned char c = i < chars.size() ? static_cast<unsigned char>(chars[i]) : 0;
+                    out.push_back(static_cast<char>(c ^ flip));
+                }
+            }
+            else {
+                size_t start = out.size();
+                // Copy the runs between '\0' bytes as they are
+                for (size_t from = 0; from <= chars.size();) {
+                    size_t to = std::min(chars.find('\0', from), chars.size());
+                    out.append(chars.data() + from, to - from);
+                    if (to < chars.size()) out.append({ '\0', static_cast<char>(0xFF) });
+                    from = to + 1;
+                }
+                out.append(2, '\0');
+                if (flip != 0) {
+                    for (size_t i = start; i < out.size(); i++) out[i] = static_cast<char>(~out[i]);
+                }
+            }
+        }
+    }
+
+    // Compare the field of a and b in the order of the encoding of the whole field: negative,
+    // zero or positive
+    template <typename T>
+    int compare(const T& a, const T& b) const {
+        using Key = std::remove_cvref_t<std::invoke_result_t<const Proj&, const T&>>;
+        decltype(auto) x = std::invoke(proj, a);
+        decltype(auto) y = std::invoke(proj, b);
+        int result;
+        if constexpr (std::is_arithmetic_v<Key>) {
+            auto kx = toRadixKey(x), ky = toRadixKey(y);
+            result = kx < ky ? -1 : ky < kx ? 1 : 0;
+        }
+        else {
+            result = std::string_view(x).compare(std::string_view(y));
+        }
+        return order == KeyOrder::Descending ? -result : result;
+    }
+};
+
+// Template function to make a field of a number or a whole string
+template <typename Proj>
+KeyField<Proj> keyField(Proj proj, KeyOrder order = KeyOrder::Ascending) {
+    return { std::move(proj), order };
+}
+
+// Template function to make a field of the first PrefixBytes bytes of a string
+template <size_t PrefixBytes, typename Proj>
+KeyField<Proj, PrefixBytes> keyPrefixField(Proj proj, KeyOrder order = KeyOrder::Ascending) {
+    static_assert(PrefixBytes > 0, "A prefix must keep at least one byte");
+    return { std::move(proj), order };
+}
+
+// Template class of a composite key: its fields, most significant first
+template <typename... Fields>
+class NormalizedKey {
+private:
+    std::tuple<Fields...> fields;
+
+    // Number of fields that are encoded: up to and including the first truncated one
+    static constexpr size_t encodedFields() {
+        constexpr bool truncated[] = { Fields::truncated..., true };
+        size_t count = 0;
+        while (count < sizeof...(Fields) && !truncated[count]) count++;
+        return count < sizeof...(Fields) ? count + 1 : count;
+    }
+
+public:
+    explicit NormalizedKey(Fields... fields) : fields(std::move(fields)...) {}
+
+    // Whether equal encodings imply equal fields
+    static constexpr bool exact = !(Fields::truncated || ...);
+
+    // Width of the encoding of elements of type T, 0 if it depends on the element
+    template <typename T>
+    static constexpr size_t width() {
+        constexpr size_t widths[] = { Fields::template width<T>()..., 0 };
+        size_t total = 0;
+        for (size_t f = 0; f < encodedFields(); f++) {
+            if (widths[f] == 0) return 0;
+            total += widths[f];
+        }
+        return total;
+    }
+
+    // Append the normalized key of element to out
+    template <typename T>
+    void encode(const T& element, std::string& out) const {
+        [&]<size_t... F>(std::index_sequence<F...>) {
+            (std::get<F>(fields).encode(element, out), ...);
+        }(std::make_index_sequence<encodedFields()>());
+    }
+
+    // Return the normalized key of element
+    template <typename T>
+    std::string encode(const T& element) const {
+        std::string out;
+        encode(element, out);
+        return out;
+    }
+
+    // Whether a comes before b on all fields, without encoding them
+    template <typename T>
+    bool less(const T& a, const T& b) const {
+        int result = 0;
+        std::apply([&](const Fields&... field) {
+            ((result == 0 ? (result = field.compare(a, b), 0) : 0), ...);
+            }, fields);
+        return result < 0;
+    }
+};
+
+// Template function to make a normalized key from its fields, most significant first
+template <typename... Fields>
+NormalizedKey<Fields...> normalizedKey(Fields... fields) {
+    static_assert(sizeof...(Fields) > 0, "A key needs at least one field");
+    return NormalizedKey<Fields...>(std::move(fields)...);
+}
+
+// Normalized key of an element, pointing into the buffer of all keys, and its position
+struct NormalizedKeyEntry {
+    std::string_view key;
+    size_t index;
+};
+
+// Template function to order runs of entries with equal keys by the full fields of their
+// elements. Merge sort is stable, so elements with equal fields stay in input order.
+template <typename RandomIt, typename Key>
+void orderEqualKeys(RandomIt first, std::vector<NormalizedKeyEntry>& entries, const Key& key) {
+    auto byFields = [&key, first](const NormalizedKeyEntry& a, const NormalizedKeyEntry& b) {
+        return key.less(first[a.index], first[b.index]);
+    };
+    std::vector<NormalizedKeyEntry> buffer;
+    for (size_t i = 0, j; i < entries.size(); i = j) {
+        for (j = i + 1; j < entries.size() && entries[j].key == entries[i].key; j++) {}
+        if (j - i > 1) mergeSortBy(entries.begin() + i, entries.begin() + j, buffer, byFields);
+    }
+}
+
+// Template function to return the permutation that sorts [first, last) by a normalized key,
+// without moving the elements
+template <std::random_access_iterator RandomIt, typename... Fields>
+std::vector<size_t> normalizedArgsort(RandomIt first, RandomIt last, const NormalizedKey<Fields...>& key) {
+    using T = std::iter_value_t<RandomIt>;
+    constexpr size_t width = NormalizedKey<Fields...>::template width<T>();
+    size_t n = static_cast<size_t>(last - first);
+
+    // Encode every key into one buffer
+    std::string bytes;
+    std::vector<size_t> offsets;
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+    if constexpr (width > 0) bytes.reserve(n * width);
+    for (size_t i = 0; i < n; i++) {
+        key.encode(first[i], bytes);
+        offsets.push_back(bytes.size());
+    }
+
+    // Radix sort the first 8 bytes of every key, packed big-endian, with its position
+    std::vector<PrefixIndex> pairs(n);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t prefix = 0;
+        for (size_t b = offsets[i]; b < offsets[i] + 8; b++) {
+            prefix = (prefix << 8) | (b < offsets[i + 1] ? static_cast<unsigned char>(bytes[b]) : 0);
+        }
+        pairs[i] = { prefix, i };
+    }
+    radixSortLSD<11>(pairs, &PrefixIndex::prefix); // Stable, so equal prefixes stay in index order
+
+    // Gather the keys in that order, so that runs of equal prefixes are contiguous
+    std::vector<NormalizedKeyEntry> entries(n);
+    for (size_t i = 0; i < n; i++) {
+        size_t index = pairs[i].index;
+        entries[i] = { std::string_view(bytes).substr(offsets[index], offsets[index + 1] - offsets[index]), index };
+    }
+
+    // Keys of up to 8 bytes are whole in their prefix. Runs of longer keys with equal prefixes
+    // are sorted on the whole keys, compared as unsigned chars like memcmp. A key shorter than
+    // 8 bytes comes before its zero padded form there.
+    if constexpr (width == 0 || width > 8) {
+        auto byKey = [](const NormalizedKeyEntry& a, const NormalizedKeyEntry& b) { return a.key < b.key; };
+        std::vector<NormalizedKeyEntry> buffer;
+        for (size_t i = 0, j; i < n; i = j) {
+            for (j = i + 1; j < n && pairs[j].prefix == pairs[i].prefix; j++) {}
+            if (j - i > 1) mergeSortBy(entries.begin() + i, entries.begin() + j, buffer, byKey);
+        }
+    }
+    if constexpr (!NormalizedKey<Fields...>::exact) {
+        orderEqualKeys(first, entries, key);
+    }
+
+    std::vector<size_t> perm(n);
+    for (size_t i = 0; i < n; i++) perm[i] = entries[i].index;
+    return perm;
+}
+
+// Template function to return the permutation that sorts a range by a normalized key
+template <SortableRange Range, typename... Fields>
+std::vector<size_t> normalizedArgsort(Range&& range, const NormalizedKey<Fields...>& key) {
+    return normalizedArgsort(std::ranges::begin(range), std::ranges::end(range), key);
+}
+
+// Template function to perform Normalized Key Sort: sort [first, last) by a normalized key
+template <std::random_access_iterator RandomIt, typename... Fields>
+void normalizedKeySort(RandomIt first, RandomIt last, const NormalizedKey<Fields...>& key) {
+    if (last - first < 2) return;
+    applyPermutation(first, last, normalizedArgsort(first, last, key));
+}
+
+// Template function to perform Normalized Key Sort on a range
+template <SortableRange Range, typename... Fields>
+void normalizedKeySort(Range&& range, const NormalizedKey<Fields...>& key) {
+    normalizedKeySort(std::ranges::begin(range), std::ranges::end(range), key);
+}
@@ -0,0 +1,191 @@
+/*
+    Parallel Merge Sort:
+    - A stable merge sort that allocates a single auxiliary buffer up front and then ping-pongs
+      between the array and the buffer, so no merge ever allocates memory.
+    - The two recursive calls are forked onto a work-stealing thread pool.
+    - Large merges are split across threads as well: the output is cut into equal chunks and the
+      co-rank (merge path) of each cut is found with a binary search, giving every thread an
+      independent sequential merge of the same size.
+    - Small sub-arrays are finished with a sorting network for integers in ascending or
+      descending order, or with insertion sort otherwise.
+
+    Time Complexity (p threads):
+    - Best Case: O(n log n / p)
+    - Average Case: O(n log n / p)
+    - Worst Case: O(n log n / p)
+    - Span: O(log^3 n)
+
+    Space Complexity: O(n)
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <algorithm> // For std::min
+#include <iterator>  // For std::iter_value_t, std::make_move_iterator
+#include <utility>   // For std::move
+
+#include "helper/ThreadPool.cpp"
+#include "helper/SortInterface.cpp"
+#include "insertion-sort.cpp"        // Used for small sub-arrays
+#include "sorting-network.cpp"      // Used for small sub-arrays of integer keys
+
+// Sub-arrays up to this size are sorted without recursing
+constexpr size_t MERGE_INSERTION_CUTOFF = 16;
+// Sub-arrays up to this size are sorted without forking
+constexpr size_t PARALLEL_SORT_CUTOFF = 1 << 13;
+// Each thread merges at least this many elements
+constexpr size_t PARALLEL_MERGE_CUTOFF = 1 << 14;
+
+// Template function to find the co-rank of k in the merge of a[0..n) and b[0..m),
+// i.e. how many of the first k merged elements come from a. Ties are taken from a first.
+template <typename It, typename Less>
+size_t coRank(size_t k, It a, size_t n, It b, size_t m, Less& less) {
+    size_t lo = k > m ? k - m : 0; // At most m elements can come from b
+    size_t hi = std::min(k, n);    // At most n elements can come from a
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        // If a[i] <= b[k - i - 1], a[i] is merged before b[k - i - 1]: take more from a
+        if (!less(b[k - i - 1], a[i])) {
+            lo = i + 1;
+        }
+        else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Template function to merge a[0..n) and b[0..m) into out sequentially
+template <typename It, typename OutIt, typename Less>
+void mergeInto(It a, size_t n, It b, size_t m, OutIt out, Less& less) {
+    size_t i = 0, j = 0;
+    while (i < n && j < m) {
+        // Take from b only if it is strictly smaller, to keep the merge stable
+        if (less(b[j], a[i])) {
+            *out++ = std::move(b[j++]);
+        }
+        else {
+            *out++ = std::move(a[i++]);
+        }
+    }
+    // Move the remaining elements of whichever half is left
+    out = std::move(a + i, a + n, out);
+    std::move(b + j, b + m, out);
+}
+
+// Template function to merge a[0..n) and b[0..m) into out, splitting the output across the pool
+template <typename It, typename OutIt, typename Less>
+void parallelMergeInto(It a, size_t n, It b, size_t m, OutIt out, ThreadPool& pool, Less& less) {
+    size_t total = n + m;
+    size_t chunks = std::min<size_t>(pool.size(), total / PARALLEL_MERGE_CUTOFF);
+    if (chunks < 2) {
+        mergeInto(a, n, b, m, out, less);
+        return;
+    }
+
+    // Find where every chunk starts in a and b before any element is moved
+    std::vector<size_t> splits(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c) {
+        splits[c] = coRank(total * c / chunks, a, n, b, m, less);
+    }
+
+    ThreadPool::TaskGroup group;
+    for (size_t c = 0; c < chunks; ++c) {
+        size_t begin = total * c / chunks, end = total * (c + 1) / chunks;
+        size_t i = splits[c], iEnd = splits[c + 1];
+        size_t j = begin - i, jEnd = end - iEnd;
+        pool.spawn(group, [=, &less] {
+            mergeInto(a + i, iEnd - i, b + j, jEnd - j, out + begin, less);
+            });
+    }
+    pool.wait(group);
+}
+
+// Template function to merge the sorted halves from[0..half) and from[half..n) into to[0..n)
+template <typename It, typename OutIt, typename Less>
+void mergeHalves(It from, OutIt to, size_t half, size_t n, ThreadPool* pool, Less& less) {
+    if (pool != nullptr) {
+        parallelMergeInto(from, half, from + half, n - half, to, *pool, less);
+    }
+    else {
+        mergeInto(from, half, from + half, n - half, to, less);
+    }
+}
+
+// Template function to sort src[0..n) using dst[0..n) as scratch space.
+// The sorted result is left in dst if toDst is set, otherwise in src.
+// With a pool the recursion and the merges are parallelized.
+template <typename SrcIt, typename DstIt, typename Less>
+void mergeSortPingPong(SrcIt src, DstIt dst, size_t n, bool toDst, ThreadPool* pool, Less& less) {
+    if (n <= MERGE_INSERTION_CUTOFF) {
+        if (!sortSmall(src, src + n, less)) insertionSortBy(src, src + n, less);
+        if (toDst) std::move(src, src + n, dst);
+        return;
+    }
+
+    size_t half = n / 2;
+    // Sort both halves into the other buffer, so that the merge lands where we want it
+    if (pool != nullptr && n > PARALLEL_SORT_CUTOFF) {
+        ThreadPool::TaskGroup group;
+        pool->spawn(group, [=, &less] { mergeSortPingPong(src, dst, half, !toDst, pool, less); });
+        mergeSortPingPong(src + half, dst + half, n - half, !toDst, pool, less);
+        pool->wait(group);
+    }
+    else {
+        mergeSortPingPong(src, dst, half, !toDst, static_cast<ThreadPool*>(nullptr), less);
+        mergeSortPingPong(src + half, dst + half, n - half, !toDst, static_cast<ThreadPool*>(nullptr), less);
+    }
+
+    // The halves are now in the buffer we are not merging into
+    if (toDst) {
+        mergeHalves(src, dst, half, n, pool, less);
+    }
+    else {
+        mergeHalves(dst, src, half, n, pool, less);
+    }
+}
+
+// Template function to perform Parallel Merge Sort on an existing pool
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void parallelMergeSort(RandomIt first, RandomIt last, ThreadPool& pool, Compare comp = Compare(), Proj proj = Proj()) {
+    size_t n = last - first;
+    if (n < 2) return;
+    auto less = projectedLess(comp, proj);
+    // The only allocation of the whole sort. The elements are moved into it (so they need no
+    // default constructor) and sorted from there back into the input.
+    std::vector<std::iter_value_t<RandomIt>> aux(std::make_move_iterator(first), std::make_move_iterator(last));
+    mergeSortPingPong(aux.begin(), first, n, true, pool.size() > 1 ? &pool : nullptr, less);
+}
+
+// Template function to perform Parallel Merge Sort on a range on an existing pool
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void parallelMergeSort(Range&& range, ThreadPool& pool, Compare comp = Compare(), Proj proj = Proj()) {
+    parallelMergeSort(std::ranges::begin(range), std::ranges::end(range), pool, comp, proj);
+}
+
+// Template function to perform Parallel Merge Sort on a range with the given number of threads
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void parallelMergeSort(Range&& range, unsigned threads, Compare comp = Compare(), Proj proj = Proj()) {
+    ThreadPool pool(threads);
+    parallelMergeSort(range, pool, comp, proj);
+}
+
+// Template function to perform Parallel Merge Sort on all hardware threads
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SortComparator<Compare, RandomIt, Proj>
+void parallelMergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    ThreadPool pool(std::thread::hardware_concurrency());
+    parallelMergeSort(first, last, pool, comp, proj);
+}
+
+// Template function to perform Parallel Merge Sort on a range on all hardware threads
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SortComparator<Compare, std::ranges::iterator_t<Range>, Proj>
+void parallelMergeSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    parallelMergeSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
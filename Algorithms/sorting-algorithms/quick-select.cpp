@@ -0,0 +1,271 @@
+/*
+    Quick Select:
+    - Selection finds the k-th smallest element without sorting everything: partition around a
+     pivot like Quick Sort, then continue only into the side that holds position k.
+    - select(first, nth, last) rearranges the range like std::nth_element: *nth is the element
+     a sort would put there, nothing before it is greater and nothing after it is smaller.
+    - multiSelect puts several positions in place at once (percentiles, say), selecting the
+     middle one and recursing into both sides with the positions they hold.
+    - partitionTopK moves the k smallest elements (the k greatest with std::greater) to the
+     front, in no particular order. percentiles returns nearest-rank percentiles.
+
+    Pivots:
+    - Large ranges use Floyd-Rivest sampling: a window of about n^(2/3) elements around
+     position k is selected recursively, so the pivot lands very close to the k-th element and
+     one partition leaves only O(n^(2/3)) elements to look at. This takes about
+     n + min(k, n - k) comparisons on average, against ~3.4n for median-of-3 quickselect.
+    - Smaller ranges use the median of 3 or Tukey's ninther, as Quick Sort does.
+    - If the range fails to shrink by at least 1/8 too often (2 log n times), the pivot becomes
+     the median of medians of groups of 5 (introselect), which guarantees linear time.
+    - Partitioning reuses the kernels of Quick Sort: the branchless block partition for
+     arithmetic keys (keys equal to a previous pivot are split off on their own), the 3-way
+     partition otherwise.
+
+    Time Complexity:
+    - Best Case: O(n)
+    - Average Case: O(n) - O(n log m) for m positions with multiSelect.
+    - Worst Case: O(n) - Thanks to the median of medians fallback.
+
+    Space Complexity: O(log n) - For the recursion into the Floyd-Rivest samples.
+    In-Place: Yes
+    Stable: No
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>  // For std::iter_swap, std::min_element, std::max_element
+#include <cmath>      // For std::log, std::exp, std::sqrt, std::ceil
+#include <cstddef>    // For std::ptrdiff_t
+#include <iterator>   // For std::iter_value_t
+#include <stdexcept>
+#include <type_traits>
+
+#include "insertion-sort.cpp"        // Used for small ranges
+#include "sorting-network.cpp"      // Used for small ranges of integer keys
+#include "quick-sort.cpp"            // Pivot selection and partition kernels
+#include "helper/SortInterface.cpp"
+
+// Ranges up to this size are sorted instead of partitioned
+constexpr std::ptrdiff_t SELECT_CUTOFF = 16;
+// Ranges larger than this take their pivot from a Floyd-Rivest sample
+constexpr std::ptrdiff_t FLOYD_RIVEST_THRESHOLD = 600;
+
+template <typename RandomIt, typename Less>
+void selectBy(RandomIt first, RandomIt nth, RandomIt last, int badAllowed, Less& less);
+
+// Template function to put the median of the medians of groups of 5 of [first, last) at first.
+// The range must hold at least 10 elements.
+template <typename RandomIt, typename Less>
+void medianOfMediansPivot(RandomIt first, RandomIt last, Less& less) {
+    std::ptrdiff_t groups = (last - first) / 5;
+    for (std::ptrdiff_t g = 0; g < groups; g++) {
+        RandomIt group = first + 5 * g;
+        insertionSortBy(group, group + 5, less);
+        std::iter_swap(first + g, group + 2); // Gather the medians at the front
+    }
+    // No bad steps allowed: the medians are selected with medians of medians all the way down
+    selectBy(first, first + groups / 2, first + groups, 0, less);
+    std::iter_swap(first, first + groups / 2);
+}
+
+// Template function to put a pivot close to the element of rank nth at first, by selecting
+// nth within a sample window around it (Floyd-Rivest)
+template <typename RandomIt, typename Less>
+void floydRivestPivot(RandomIt first, RandomIt nth, RandomIt last, int badAllowed, Less& less) {
+    double n = static_cast<double>(last - first);
+    double i = static_cast<double>(nth - first + 1);
+    double z = std::log(n);
+    double s = 0.5 * std::exp(2 * z / 3);
+    double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1);
+
+    // The window [sampleFirst, sampleLast) holds nth and, after it, at least one more element
+    std::ptrdiff_t k = nth - first;
+    std::ptrdiff_t lo = std::max<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+    std::ptrdiff_t hi = std::min<std::ptrdiff_t>(last - first, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd) + 1);
+    hi = std::max(hi, k + 2);
+    selectBy(first + lo, nth, first + hi, badAllowed, less);
+
+    // The elements after nth in the window are not less than the pivot, so after the swap
+    // one of them is still after it, as the block partition requires
+    std::iter_swap(first, nth);
+}
+
+// Template function to put the element of rank nth of [first, last) at nth, with nothing
+// greater before it and nothing smaller after it. badAllowed counts the partitions that may
+// still fail to shrink the range by 1/8 before the median of medians takes over.
+template <typename RandomIt, typename Less>
+void selectBy(RandomIt first, RandomIt nth, RandomIt last, int badAllowed, Less& less) {
+    bool leftmost = true; // Whether the element before first is not a previous pivot
+    while (true) {
+        std::ptrdiff_t size = last - first;
+        if (size <= SELECT_CUTOFF) {
+            if (size > 1 && !sortSmall(first, last, less)) {
+                insertionSortBy(first, last, less);
+            }
+            return;
+        }
+        // The smallest and the largest elements only need one scan
+        if (nth == first) {
+            std::iter_swap(first, std::min_element(first, last, less));
+            return;
+        }
+        if (nth == last - 1) {
+            std::iter_swap(last - 1, std::max_element(first, last, less));
+            return;
+        }
+
+        // Put the pivot at first, with an element not less than it somewhere after it
+        if (badAllowed == 0) {
+            medianOfMediansPivot(first, last, less);
+        }
+        else if (size > FLOYD_RIVEST_THRESHOLD) {
+            floydRivestPivot(first, nth, last, badAllowed, less);
+        }
+        else {
+            // Same setup as in blockIntroSort: sorting the samples leaves a key not less than
+            // the pivot at the end
+            std::ptrdiff_t mid = size / 2;
+            if (size > NINTHER_THRESHOLD) {
+                sort3(first, first + mid, last - 1, less);
+                sort3(first + 1, first + (mid - 1), last - 2, less);
+                sort3(first + 2, first + (mid + 1), last - 3, less);
+                sort3(first + (mid - 1), first + mid, first + (mid + 1), less);
+                std::iter_swap(first, first + mid);
+            }
+            else {
+                sort3(first + mid, first, last - 1, less);
+            }
+        }
+
+        if constexpr (std::is_arithmetic_v<std::iter_value_t<RandomIt>>) {
+            // Keys equal to the previous pivot just before the range are split off, and are
+            // all at their final positions
+            if (!leftmost && !less(*(first - 1), *first)) {
+                RandomIt equalLast = partitionEqualLeft(first, last, less) + 1;
+                if (nth < equalLast) return;
+                first = equalLast;
+                continue;
+            }
+
+            bool alreadyPartitioned;
+            RandomIt pivotPos = blockPartition(first, last, less, alreadyPartitioned);
+            if (nth == pivotPos) return;
+            if (nth < pivotPos) {
+                last = pivotPos;
+            }
+            else {
+                first = pivotPos + 1;
+                leftmost = false;
+            }
+        }
+        else {
+            std::ptrdiff_t lt, gt;
+            partition3Way(first, 0, size - 1, lt, gt, less);
+            if (nth >= first + lt && nth <= first + gt) return; // Among the keys equal to the pivot
+            if (nth < first + lt) {
+                last = first + lt;
+            }
+            else {
+                first = first + gt + 1;
+            }
+        }
+
+        // A step that kept more than 7/8 of the range counts as bad
+        if (badAllowed > 0 && last - first > size - size / 8) badAllowed--;
+    }
+}
+
+// Function to get the number of bad partitions allowed on n elements: about 2 log2(n)
+inline int selectBadAllowed(std::ptrdiff_t n) {
+    int allowed = 1;
+    for (; n > 1; n >>= 1) allowed += 2;
+    return allowed;
+}
+
+// Template function to put the elements of the sorted, distinct ranks [ranks, ranksEnd)
+// (counted from base) in place within [first, last)
+template <typename RandomIt, typename Less>
+void multiSelectBy(RandomIt base, RandomIt first, RandomIt last, const size_t* ranks, const size_t* ranksEnd, Less& less) {
+    if (ranks == ranksEnd) return;
+    const size_t* middle = ranks + (ranksEnd - ranks) / 2;
+    RandomIt nth = base + *middle;
+    selectBy(first, nth, last, selectBadAllowed(last - first), less);
+    multiSelectBy(base, first, nth, ranks, middle, less);
+    multiSelectBy(base, nth + 1, last, middle + 1, ranksEnd, less);
+}
+
+// Template function to perform Quick Select: put the element of rank nth - first at nth
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void select(RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    if (nth >= last) return;
+    auto less = projectedLess(comp, proj);
+    selectBy(first, nth, last, selectBadAllowed(last - first), less);
+}
+
+// Template function to perform Quick Select on a range. Returns an iterator to the element of rank k.
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+auto select(Range&& range, size_t k, Compare comp = Compare(), Proj proj = Proj()) {
+    auto first = std::ranges::begin(range), last = std::ranges::end(range);
+    if (k >= static_cast<size_t>(last - first)) throw std::out_of_range("Rank out of range");
+    select(first, first + k, last, comp, proj);
+    return first + k;
+}
+
+// Template function to put the elements of every rank in ranks (counted from first) in place.
+// Between two consecutive ranks, elements are only partitioned.
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void multiSelect(RandomIt first, RandomIt last, std::vector<size_t> ranks, Compare comp = Compare(), Proj proj = Proj()) {
+    size_t n = static_cast<size_t>(last - first);
+    for (size_t rank : ranks) {
+        if (rank >= n) throw std::out_of_range("Rank out of range");
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    auto less = projectedLess(comp, proj);
+    multiSelectBy(first, first, last, ranks.data(), ranks.data() + ranks.size(), less);
+}
+
+// Template function to put the elements of every rank in ranks in place in a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void multiSelect(Range&& range, std::vector<size_t> ranks, Compare comp = Compare(), Proj proj = Proj()) {
+    multiSelect(std::ranges::begin(range), std::ranges::end(range), std::move(ranks), comp, proj);
+}
+
+// Template function to move the k smallest elements of [first, last) to [first, first + k),
+// in no particular order
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void partitionTopK(RandomIt first, RandomIt last, size_t k, Compare comp = Compare(), Proj proj = Proj()) {
+    if (k == 0 || k >= static_cast<size_t>(last - first)) return;
+    // Selecting rank k leaves the k smaller ones before it
+    select(first, first + k, last, comp, proj);
+}
+
+// Template function to move the k smallest elements of a range to its front
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void partitionTopK(Range&& range, size_t k, Compare comp = Compare(), Proj proj = Proj()) {
+    partitionTopK(std::ranges::begin(range), std::ranges::end(range), k, comp, proj);
+}
+
+// Template function to return the nearest-rank percentiles (fractions in [0, 1]) of a range:
+// the element of rank ceil(p n) - 1. The range is rearranged by multiSelect.
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+auto percentiles(Range&& range, const std::vector<double>& fractions, Compare comp = Compare(), Proj proj = Proj()) {
+    auto first = std::ranges::begin(range), last = std::ranges::end(range);
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) throw std::invalid_argument("Percentiles of an empty range");
+
+    std::vector<size_t> ranks;
+    for (double p : fractions) {
+        if (!(p >= 0 && p <= 1)) throw std::invalid_argument("Percentiles must be between 0 and 1");
+        size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(n)));
+        ranks.push_back(rank == 0 ? 0 : rank - 1);
+    }
+    multiSelect(first, last, ranks, comp, proj);
+
+    std::vector<std::iter_value_t<decltype(first)>> values;
+    for (size_t rank : ranks) values.push_back(first[rank]);
+    return values;
+}
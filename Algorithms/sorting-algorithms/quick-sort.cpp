@@ -4,68 +4,461 @@
      array into two sub-arrays.
     - It then recursively sorts the sub-arrays.
 
+    This is the introsort variant:
+    - The pivot is the median of 3 elements, or Tukey's ninther (median of 3 medians of 3) on
+     larger sub-arrays, which makes sorted, reversed and organ-pipe inputs behave like random ones.
+    - Partitioning is 3-way (Bentley-McIlroy), so keys equal to the pivot are gathered in the
+     middle and never looked at again. Inputs with many duplicates take linear time.
+    - Small sub-arrays are finished with a sorting network for integers in ascending or
+     descending order, or with insertion sort otherwise.
+    - Recursion goes into the smaller side only and the depth is limited to 2 log n. Past the
+     limit the sub-array is handed to heap sort, which bounds the worst case to O(n log n).
+
+    Arithmetic keys use the block partition (BlockQuicksort / pdqsort) instead:
+    - The partition scans a block of 64 elements from each end and only records, without
+     branching, the offsets of the elements on the wrong side. The recorded elements are then
+     swapped in bulk. The comparisons no longer decide any branch, so the ~50% branch
+     mispredictions of a classic partition on random keys disappear.
+    - A partition that did not have to move anything means the range was probably sorted
+     already: both sides are then tried with an insertion sort that gives up after a few moves.
+    - If the pivot equals the element just before the range (the previous pivot), every key
+     equal to it is split off to the left and never touched again, handling duplicates.
+    - A highly unbalanced partition swaps a few elements around to break up patterns. After
+     log n of them the range is handed to heap sort.
+
     Time Complexity:
-    - Best Case: O(n log n) - When the pivot divides the array into two equal halves.
+    - Best Case: O(n) - When all keys are equal.
     - Average Case: O(n log n) - When the pivot divides the array into two sub-arrays of almost equal size.
-    - Worst Case: O(n^2) - When the pivot divides the array into two sub-arrays of size 1 and n-1.
+    - Worst Case: O(n log n) - When bad pivots hit the depth limit and heap sort takes over.
 
-    Space Complexity: O(log n) - For the recursive call stack.
+    Space Complexity: O(log n) - For the recursive call stack (plus two 64-byte offset blocks).
     In-Place: Yes
     Stable: No
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
-#include <random> // For std::random_device and std::mt19937
-#include <algorithm> // For std::swap and std::shuffle
-
-
-// Template function to partition the array
-// Use the first element as the pivot
-template <typename T>
-int partition(std::vector<T>& arr, int low, int high) {
-    T pivot = arr[low]; // Choose the first element as the pivot
-    int i = low + 1;    // Index of the first element after the pivot
-    int j = high;       // Index of the last element
-
-    // While the indexes do not cross
-    while (i <= j) {
-        // Move i to the right until we find an element greater than the pivot
-        while (i <= j && arr[i] <= pivot) {
-            i++;
-        }
-        // Move j to the left until we find an element less than the pivot
-        while (i <= j && arr[j] > pivot) {
-            j--;
-        }
-        // If the indexes have not crossed, swap the elements
-        if (i < j) std::swap(arr[i], arr[j]);
-    }
-    // Swap the pivot with the element at index j
-    std::swap(arr[low], arr[j]);
-    // Return the index of the pivot element
-    return j;
+#include <algorithm> // For std::iter_swap
+#include <cstddef>   // For std::ptrdiff_t
+#include <cstdint>   // For uint8_t
+#include <iterator>  // For std::iter_value_t
+#include <type_traits>
+
+#include "insertion-sort.cpp"        // Used for small sub-arrays
+#include "sorting-network.cpp"      // Used for small sub-arrays of integer keys
+#include "heap-sort.cpp"             // Used when the recursion gets too deep
+#include "helper/SortInterface.cpp"
+
+// Sub-arrays up to this size are sorted without partitioning
+constexpr int QUICKSORT_CUTOFF = 16;
+// Sub-arrays larger than this use the ninther instead of the median of 3
+constexpr int NINTHER_THRESHOLD = 40;
+// Elements scanned per side and block by the block partition (offsets must fit in a byte)
+constexpr size_t PARTITION_BLOCK = 64;
+// Moves after which the insertion sort of an already partitioned range gives up
+constexpr size_t PARTIAL_INSERTION_LIMIT = 8;
+
+// Template function to return the index of the median of arr[a], arr[b] and arr[c]
+template <typename RandomIt, typename Less>
+std::ptrdiff_t medianOf3(RandomIt arr, std::ptrdiff_t a, std::ptrdiff_t b, std::ptrdiff_t c, Less& less) {
+    if (less(arr[a], arr[b])) {
+        if (less(arr[b], arr[c])) return b;
+        return less(arr[a], arr[c]) ? c : a;
+    }
+    if (less(arr[a], arr[c])) return a;
+    return less(arr[b], arr[c]) ? c : b;
+}
+
+// Template function to choose the pivot index for arr[low..high]
+template <typename RandomIt, typename Less>
+std::ptrdiff_t choosePivot(RandomIt arr, std::ptrdiff_t low, std::ptrdiff_t high, Less& less) {
+    std::ptrdiff_t n = high - low + 1;
+    std::ptrdiff_t mid = low + n / 2;
+    if (n <= NINTHER_THRESHOLD) {
+        return medianOf3(arr, low, mid, high, less);
+    }
+
+    // Tukey's ninther: the median of the medians of three evenly spaced triples
+    std::ptrdiff_t eps = n / 8;
+    std::ptrdiff_t m1 = medianOf3(arr, low, low + eps, low + 2 * eps, less);
+    std::ptrdiff_t m2 = medianOf3(arr, mid - eps, mid, mid + eps, less);
+    std::ptrdiff_t m3 = medianOf3(arr, high - 2 * eps, high - eps, high, less);
+    return medianOf3(arr, m1, m2, m3, less);
+}
+
+// Template function to 3-way partition arr[low..high] around the pivot arr[low]
+// On return arr[low..lt-1] < pivot, arr[lt..gt] == pivot and arr[gt+1..high] > pivot
+template <typename RandomIt, typename Less>
+void partition3Way(RandomIt arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t& lt, std::ptrdiff_t& gt, Less& less) {
+    const auto& pivot = arr[low]; // arr[low] is not moved until the final swaps
+    std::ptrdiff_t i = low, j = high + 1; // Scanning indexes
+    std::ptrdiff_t p = low, q = high + 1; // arr[low..p] and arr[q..high] hold keys equal to the pivot
+
+    while (true) {
+        // Move i to the right until we find an element not less than the pivot
+        while (less(arr[++i], pivot)) {
+            if (i == high) break;
+        }
+        // Move j to the left until we find an element not greater than the pivot
+        while (less(pivot, arr[--j])) {
+            if (j == low) break;
+        }
+
+        // If the indexes met on a key equal to the pivot, move it to the left end
+        if (i == j && !less(arr[i], pivot) && !less(pivot, arr[i])) {
+            std::iter_swap(arr + ++p, arr + i);
+        }
+        // Stop once the indexes have crossed
+        if (i >= j) break;
+
+        std::iter_swap(arr + i, arr + j);
+        // Move keys equal to the pivot to the ends of the sub-array
+        if (!less(arr[i], pivot)) std::iter_swap(arr + ++p, arr + i);
+        if (!less(pivot, arr[j])) std::iter_swap(arr + --q, arr + j);
+    }
+
+    // Swap the equal keys from both ends into the middle
+    i = j + 1;
+    for (std::ptrdiff_t k = low; k <= p; k++) std::iter_swap(arr + k, arr + j--);
+    for (std::ptrdiff_t k = high; k >= q; k--) std::iter_swap(arr + k, arr + i++);
+
+    lt = j + 1;
+    gt = i - 1;
+}
+
+// Template function to perform introsort on arr[low..high] with the given depth budget
+template <typename RandomIt, typename Less>
+void introSort(RandomIt arr, std::ptrdiff_t low, std::ptrdiff_t high, int depthLimit, Less& less) {
+    while (high - low + 1 > QUICKSORT_CUTOFF) {
+        // Too many bad pivots: switch to heap sort to stay O(n log n)
+        if (depthLimit-- == 0) {
+            makeHeap(arr + low, high - low + 1, less);
+            sortHeap(arr + low, high - low + 1, less);
+            return;
+        }
+
+        // Move the chosen pivot to the front and partition around it
+        std::iter_swap(arr + low, arr + choosePivot(arr, low, high, less));
+        std::ptrdiff_t lt, gt;
+        partition3Way(arr, low, high, lt, gt, less);
+
+        // Recurse into the smaller side and loop on the larger one to bound the stack
+        if (lt - low < high - gt) {
+            introSort(arr, low, lt - 1, depthLimit, less);
+            low = gt + 1;
+        }
+        else {
+            introSort(arr, gt + 1, high, depthLimit, less);
+            high = lt - 1;
+        }
+    }
+    // Finish small sub-arrays with a sorting network, or insertion sort if there is none
+    if (high > low && !sortSmall(arr + low, arr + high + 1, less)) {
+        insertionSortBy(arr + low, arr + high + 1, less);
+    }
+}
+
+// Template function to sort *a, *b and *c in place
+template <typename RandomIt, typename Less>
+void sort3(RandomIt a, RandomIt b, RandomIt c, Less& less) {
+    if (less(*b, *a)) std::iter_swap(a, b);
+    if (less(*c, *b)) std::iter_swap(b, c);
+    if (less(*b, *a)) std::iter_swap(a, b);
 }
 
-// Template function to perform Quick Sort
-template <typename T>
-void quickSort(std::vector<T>& arr, int low, int high) {
-    if (low >= high) return; // Base case: 0 or 1 element
+// Template function to insertion sort [first, last), giving up (with the range partly sorted)
+// once more than PARTIAL_INSERTION_LIMIT elements had to be moved. Returns whether it finished.
+template <typename RandomIt, typename Less>
+bool partialInsertionSort(RandomIt first, RandomIt last, Less& less) {
+    if (first == last) return true;
+    size_t moved = 0;
+    for (RandomIt i = first + 1; i != last; ++i) {
+        // Compare first, so that elements already in place are not moved at all
+        if (!less(*i, *(i - 1))) continue;
+        auto key = std::move(*i);
+        RandomIt j = i;
+        do {
+            *j = std::move(*(j - 1));
+            --j;
+        } while (j != first && less(key, *(j - 1)));
+        *j = std::move(key);
 
-    // Partition the array
-    int pivot = partition(arr, low, high);
-    // Recursively sort the left and right sub-arrays
-    quickSort(arr, low, pivot - 1);
-    quickSort(arr, pivot + 1, high);
+        moved += i - j;
+        if (moved > PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
 }
 
-// Wrapper function to call Quick Sort
-template <typename T>
-void quickSort(std::vector<T>& arr) {
-    // First shuffle the array to avoid worst-case time complexity
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(arr.begin(), arr.end(), g);
-    // Call the recursive function
-    quickSort(arr, 0, arr.size() - 1);
-}
\ No newline at end of file
+// Template function to move the elements at the recorded offsets of the left block (counted
+// from leftBase) and the right block (counted back from rightBase) to the other side.
+// Plain swaps are used when both blocks are full, which keeps reversed inputs linear;
+// otherwise a cyclic rotation needs one move per element instead of three.
+template <typename RandomIt, typename Less>
+void swapOffsets(RandomIt leftBase, RandomIt rightBase, const uint8_t* left, const uint8_t* right,
+    size_t count, bool useSwaps) {
+    if (useSwaps) {
+        for (size_t i = 0; i < count; i++) {
+            std::iter_swap(leftBase + left[i], rightBase - right[i]);
+        }
+    }
+    else if (count > 0) {
+        RandomIt l = leftBase + left[0];
+        RandomIt r = rightBase - right[0];
+        auto temp = std::move(*l);
+        *l = std::move(*r);
+        for (size_t i = 1; i < count; i++) {
+            l = leftBase + left[i];
+            *r = std::move(*l);
+            r = rightBase - right[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(temp);
+    }
+}
+
+// Template function to partition [first, last) around the pivot *first with block partitioning.
+// Keys equal to the pivot go right. Returns the final position of the pivot and sets
+// alreadyPartitioned if no element had to be moved.
+// Requires an element not less than the pivot after it and, unless first[1] is smaller than the
+// pivot, an element smaller than the pivot somewhere (both are set up by the pivot selection).
+template <typename RandomIt, typename Less>
+RandomIt blockPartition(RandomIt first, RandomIt last, Less& less, bool& alreadyPartitioned) {
+    auto pivot = std::move(*first);
+    RandomIt begin = first;
+
+    // Skip the prefix and the suffix that are already on the correct side
+    while (less(*++first, pivot));
+    if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot));
+    }
+    else {
+        while (!less(*--last, pivot));
+    }
+
+    alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned) {
+        std::iter_swap(first, last);
+        ++first;
+
+        // Offsets of the misplaced elements found by the current left and right blocks
+        alignas(64) uint8_t leftOffsets[PARTITION_BLOCK];
+        alignas(64) uint8_t rightOffsets[PARTITION_BLOCK];
+        RandomIt leftBase = first, rightBase = last;
+        size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+        while (first < last) {
+            // Refill whichever blocks are empty, splitting what is left if it is less than two blocks
+            size_t unknown = last - first;
+            size_t leftSplit = numLeft == 0 ? (numRight == 0 ? unknown / 2 : unknown) : 0;
+            size_t rightSplit = numRight == 0 ? unknown - leftSplit : 0;
+
+            // Record the offsets of elements not less than the pivot, without branching on them
+            size_t leftScan = std::min(leftSplit, PARTITION_BLOCK);
+            for (size_t i = 0; i < leftScan; i++) {
+                leftOffsets[numLeft] = static_cast<uint8_t>(i);
+                numLeft += !less(*first, pivot);
+                ++first;
+            }
+            // Record the offsets (counted back from rightBase) of elements less than the pivot
+            size_t rightScan = std::min(rightSplit, PARTITION_BLOCK);
+            for (size_t i = 0; i < rightScan; i++) {
+                rightOffsets[numRight] = static_cast<uint8_t>(i + 1);
+                numRight += less(*--last, pivot);
+            }
+
+            // Swap as many pairs as both blocks have
+            size_t count = std::min(numLeft, numRight);
+            swapOffsets<RandomIt, Less>(leftBase, rightBase, leftOffsets + startLeft, rightOffsets + startRight,
+                count, numLeft == numRight);
+            numLeft -= count;
+            numRight -= count;
+            startLeft += count;
+            startRight += count;
+
+            // A block that has been used up starts over at the current scanning position
+            if (numLeft == 0) {
+                startLeft = 0;
+                leftBase = first;
+            }
+            if (numRight == 0) {
+                startRight = 0;
+                rightBase = last;
+            }
+        }
+
+        // Only one block can still have misplaced elements: move them to the boundary
+        if (numLeft > 0) {
+            while (numLeft-- > 0) std::iter_swap(leftBase + leftOffsets[startLeft + numLeft], --last);
+            first = last;
+        }
+        if (numRight > 0) {
+            while (numRight-- > 0) std::iter_swap(rightBase - rightOffsets[startRight + numRight], first++);
+            last = first;
+        }
+    }
+
+    // Put the pivot between the two sides
+    RandomIt pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return pivotPos;
+}
+
+// Template function to partition [first, last) around the pivot *first, putting keys equal to
+// the pivot on the left. Used when the pivot equals the previous one: the left side then only
+// holds keys equal to the pivot and is already sorted. Returns the final position of the pivot.
+template <typename RandomIt, typename Less>
+RandomIt partitionEqualLeft(RandomIt first, RandomIt last, Less& less) {
+    auto pivot = std::move(*first);
+    RandomIt begin = first, end = last;
+
+    // Skip the suffix greater than the pivot and the prefix not greater than it. The scan from
+    // the left is guarded only if nothing stopped the scan from the right before the end.
+    while (less(pivot, *--last));
+    if (last + 1 == end) {
+        while (first < last && !less(pivot, *++first));
+    }
+    else {
+        while (!less(pivot, *++first));
+    }
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (less(pivot, *--last));
+        while (!less(pivot, *++first));
+    }
+
+    *begin = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
+
+// Template function to sort [first, last) with block partitioning. leftmost is false if the
+// element before first is not greater than any element of the range (a previous pivot).
+template <typename RandomIt, typename Less>
+void blockIntroSort(RandomIt first, RandomIt last, int badAllowed, bool leftmost, Less& less) {
+    while (true) {
+        std::ptrdiff_t size = last - first;
+        if (size <= QUICKSORT_CUTOFF) {
+            // Finish small sub-arrays with a sorting network, or insertion sort if there is none
+            if (size > 1 && !sortSmall(first, last, less)) {
+                insertionSortBy(first, last, less);
+            }
+            return;
+        }
+
+        // Put the median of 3 (or the ninther) at first. Sorting the samples in place leaves a
+        // key not less than the pivot at the end, and one not greater than it in the middle.
+        std::ptrdiff_t mid = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(first, first + mid, last - 1, less);
+            sort3(first + 1, first + (mid - 1), last - 2, less);
+            sort3(first + 2, first + (mid + 1), last - 3, less);
+            sort3(first + (mid - 1), first + mid, first + (mid + 1), less);
+            std::iter_swap(first, first + mid);
+        }
+        else {
+            sort3(first + mid, first, last - 1, less);
+        }
+
+        // If the pivot equals the previous pivot just before the range, nothing in the range is
+        // smaller than it: split off the keys equal to it, which are done
+        if (!leftmost && !less(*(first - 1), *first)) {
+            first = partitionEqualLeft(first, last, less) + 1;
+            continue;
+        }
+
+        bool alreadyPartitioned;
+        RandomIt pivotPos = blockPartition(first, last, less, alreadyPartitioned);
+        std::ptrdiff_t leftSize = pivotPos - first;
+        std::ptrdiff_t rightSize = last - (pivotPos + 1);
+
+        if (leftSize < size / 8 || rightSize < size / 8) {
+            // Too many bad pivots: switch to heap sort to stay O(n log n)
+            if (--badAllowed == 0) {
+                makeHeap(first, size, less);
+                sortHeap(first, size, less);
+                return;
+            }
+            // Swap a few elements of each side to break the pattern that caused the bad pivot
+            if (leftSize > QUICKSORT_CUTOFF) {
+                std::iter_swap(first, first + leftSize / 4);
+                std::iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+                if (leftSize > NINTHER_THRESHOLD) {
+                    std::iter_swap(first + 1, first + (leftSize / 4 + 1));
+                    std::iter_swap(first + 2, first + (leftSize / 4 + 2));
+                    std::iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+                    std::iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+                }
+            }
+            if (rightSize > QUICKSORT_CUTOFF) {
+                std::iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+                std::iter_swap(last - 1, last - rightSize / 4);
+                if (rightSize > NINTHER_THRESHOLD) {
+                    std::iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+                    std::iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+                    std::iter_swap(last - 2, last - (1 + rightSize / 4));
+                    std::iter_swap(last - 3, last - (2 + rightSize / 4));
+                }
+            }
+        }
+        else if (alreadyPartitioned && partialInsertionSort(first, pivotPos, less)
+            && partialInsertionSort(pivotPos + 1, last, less)) {
+            // The partition moved nothing and both sides were (nearly) sorted
+            return;
+        }
+
+        // Recurse into the left side and loop on the right one. Both sides of a balanced
+        // partition hold at least 1/8 of the elements, so the depth stays O(log n).
+        blockIntroSort(first, pivotPos, badAllowed, leftmost, less);
+        first = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+// Template function to perform Quick Sort with 3-way partitioning on [first, last)
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void quickSort3Way(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    if (last - first < 2) return; // Base case: 0 or 1 element
+    auto less = projectedLess(comp, proj);
+
+    // Allow 2 * floor(log2(n)) levels of partitioning before falling back to heap sort
+    int depthLimit = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        depthLimit += 2;
+    }
+    introSort(first, 0, last - first - 1, depthLimit, less);
+}
+
+// Template function to perform Quick Sort with block partitioning on [first, last)
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void blockQuickSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    if (last - first < 2) return; // Base case: 0 or 1 element
+    auto less = projectedLess(comp, proj);
+
+    // Allow floor(log2(n)) highly unbalanced partitions before falling back to heap sort
+    int badAllowed = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        badAllowed++;
+    }
+    blockIntroSort(first, last, badAllowed, true, less);
+}
+
+// Template function to perform Quick Sort on [first, last): block partitioning for arithmetic
+// keys, where comparisons are cheap and branch mispredictions dominate, 3-way otherwise
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void quickSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    if constexpr (std::is_arithmetic_v<std::iter_value_t<RandomIt>>) {
+        blockQuickSort(first, last, comp, proj);
+    }
+    else {
+        quickSort3Way(first, last, comp, proj);
+    }
+}
+
+// Template function to perform Quick Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void quickSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    quickSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -0,0 +1,217 @@
+/*
+    Radix Sort:
+    - Radix Sort is not comparison-based. It splits every key into fixed-size digits and sorts
+     the array one digit at a time with counting sort.
+    - Keys are taken from the elements through a projection, so records can be sorted by one
+     of their fields. The key may be any integer or floating point type.
+    - Signed and floating point keys are mapped to unsigned integers with the same order:
+     the sign bit of signed integers is flipped, negative floats have all their bits flipped
+     and non-negative floats have only the sign bit flipped. -0.0 is sorted as 0.0, so equal
+     zeros keep their input order.
+
+    LSD (least significant digit first):
+    - Works with 8, 11 or 16-bit digits. The histograms of all digits are built in a single
+     pass over the input, and passes in which every key has the same digit are skipped.
+
+    MSD (most significant digit first):
+    - Partitions by the top 8-bit digit and recurses into every bucket with the next digit.
+     Small buckets are finished with insertion sort, so the recursion stops early on
+     short or already distinct keys.
+
+    Time Complexity (w-bit keys, d-bit digits):
+    - Best Case: O(n) - When all keys share the same high digits (passes are skipped).
+    - Average Case: O(n * w / d)
+    - Worst Case: O(n * w / d)
+
+    Space Complexity: O(n + 2^d)
+    In-Place: No
+    Stable: Yes
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>     // For std::memcpy
+#include <limits>
+#include <type_traits>
+#include <functional>  // For std::invoke, std::identity
+#include <utility>     // For std::move
+
+#include "helper/SortInterface.cpp"
+
+// Sub-arrays up to this size are insertion sorted by the MSD radix sort
+constexpr size_t MSD_INSERTION_CUTOFF = 32;
+
+// Template function to map a key to an unsigned integer that sorts in the same order
+template <typename K>
+auto toRadixKey(K key) {
+    static_assert(std::is_arithmetic_v<K>, "Radix sort keys must be integer or floating point");
+    if constexpr (std::is_floating_point_v<K>) {
+        using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+        static_assert(sizeof(K) == sizeof(U), "Only 32 and 64-bit floating point keys are supported");
+        U bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+        // Negative values flip all bits (reversing their order), positive ones just the sign
+        return (bits & signBit) ? static_cast<U>(~bits) : static_cast<U>(bits | signBit);
+    }
+    else if constexpr (std::is_signed_v<K>) {
+        using U = std::make_unsigned_t<K>;
+        constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+        return static_cast<U>(static_cast<U>(key) ^ signBit);
+    }
+    else {
+        return key;
+    }
+}
+
+// Template function to map a key to the unsigned integer the radix passes sort by. -0.0 becomes
+// 0.0 first: the two compare equal, so they must get the same key to stay in input order.
+template <typename K>
+auto radixSortKey(K key) {
+    if constexpr (std::is_floating_point_v<K>) {
+        if (key == 0) key = 0;
+    }
+    return toRadixKey(key);
+}
+
+// Template function to perform LSD Radix Sort on a[0..n) with DigitBits-bit digits
+template <unsigned DigitBits, typename T, typename Proj>
+void radixPassesLSD(T* a, size_t n, Proj& proj) {
+    static_assert(DigitBits >= 1 && DigitBits <= 16, "Digits must be between 1 and 16 bits wide");
+    using U = decltype(radixSortKey(std::invoke(proj, a[0])));
+    constexpr unsigned KEY_BITS = sizeof(U) * 8;
+    constexpr unsigned PASSES = (KEY_BITS + DigitBits - 1) / DigitBits;
+    constexpr size_t BUCKETS = size_t(1) << DigitBits;
+    constexpr U MASK = static_cast<U>(BUCKETS - 1);
+
+    if (n < 2) return;
+
+    // Build the histogram of every digit in a single pass over the input
+    std::vector<size_t> counts(PASSES * BUCKETS, 0);
+    for (size_t i = 0; i < n; i++) {
+        U k = radixSortKey(std::invoke(proj, a[i]));
+        for (unsigned p = 0; p < PASSES; p++) {
+            counts[p * BUCKETS + ((k >> (p * DigitBits)) & MASK)]++;
+        }
+    }
+
+    std::vector<T> aux(a, a + n); // Overwritten by the first pass; copied so T needs no default constructor
+    T* from = a;
+    T* to = aux.data();
+    for (unsigned p = 0; p < PASSES; p++) {
+        size_t* count = &counts[p * BUCKETS];
+        unsigned shift = p * DigitBits;
+
+        // Skip the pass if every key has the same digit here
+        if (count[(radixSortKey(std::invoke(proj, from[0])) >> shift) & MASK] == n) continue;
+
+        // Turn the counts into starting offsets
+        size_t offset = 0;
+        for (size_t d = 0; d < BUCKETS; d++) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+
+        // Scatter the elements into their buckets, keeping equal digits in order
+        for (size_t i = 0; i < n; i++) {
+            size_t d = (radixSortKey(std::invoke(proj, from[i])) >> shift) & MASK;
+            to[count[d]++] = std::move(from[i]);
+        }
+        std::swap(from, to);
+    }
+
+    // After an odd number of passes the result is in the auxiliary array
+    if (from != a) {
+        std::move(from, from + n, a);
+    }
+}
+
+// Template function to perform LSD Radix Sort with DigitBits-bit digits
+template <unsigned DigitBits = 8, std::random_access_iterator RandomIt, typename Proj = std::identity>
+void radixSortLSD(RandomIt first, RandomIt last, Proj proj = Proj()) {
+    sortContiguous(first, last, [&proj](auto* a, size_t n) { radixPassesLSD<DigitBits>(a, n, proj); });
+}
+
+// Template function to perform LSD Radix Sort on a range with DigitBits-bit digits
+template <unsigned DigitBits = 8, SortableRange Range, typename Proj = std::identity>
+void radixSortLSD(Range&& range, Proj proj = Proj()) {
+    radixSortLSD<DigitBits>(std::ranges::begin(range), std::ranges::end(range), proj);
+}
+
+// Template function to insertion sort a[0..n) by radix key
+template <typename T, typename Proj>
+void radixInsertionSort(T* a, size_t n, Proj& proj) {
+    for (size_t i = 1; i < n; i++) {
+        T value = std::move(a[i]);
+        auto k = radixSortKey(std::invoke(proj, value));
+        size_t j = i;
+        // Shift the elements with larger keys one place to the right
+        while (j > 0 && k < radixSortKey(std::invoke(proj, a[j - 1]))) {
+            a[j] = std::move(a[j - 1]);
+            j--;
+        }
+        a[j] = std::move(value);
+    }
+}
+
+// Template function to MSD Radix Sort a[0..n) on the 8-bit digit at `shift` and below
+template <typename T, typename Proj>
+void radixSortMSD(T* a, T* aux, size_t n, int shift, Proj& proj) {
+    if (n <= MSD_INSERTION_CUTOFF) {
+        radixInsertionSort(a, n, proj);
+        return;
+    }
+
+    // Count the keys per digit and turn the counts into bucket offsets
+    size_t count[257] = {};
+    for (size_t i = 0; i < n; i++) {
+        count[((radixSortKey(std::invoke(proj, a[i])) >> shift) & 0xFF) + 1]++;
+    }
+    for (int d = 0; d < 256; d++) {
+        count[d + 1] += count[d];
+    }
+
+    // Distribute into the auxiliary array and copy back
+    size_t next[256];
+    std::memcpy(next, count, sizeof(next));
+    for (size_t i = 0; i < n; i++) {
+        aux[next[(radixSortKey(std::invoke(proj, a[i])) >> shift) & 0xFF]++] = std::move(a[i]);
+    }
+    std::move(aux, aux + n, a);
+
+    // Recurse into every bucket on the next digit
+    if (shift == 0) return;
+    for (int d = 0; d < 256; d++) {
+        size_t size = count[d + 1] - count[d];
+        if (size > 1) {
+            radixSortMSD(a + count[d], aux + count[d], size, shift - 8, proj);
+        }
+    }
+}
+
+// Template function to perform MSD Radix Sort
+template <std::random_access_iterator RandomIt, typename Proj = std::identity>
+void radixSortMSD(RandomIt first, RandomIt last, Proj proj = Proj()) {
+    sortContiguous(first, last, [&proj](auto* a, size_t n) {
+        if (n < 2) return;
+        using U = decltype(radixSortKey(std::invoke(proj, a[0])));
+        std::vector<std::remove_pointer_t<decltype(a)>> aux(a, a + n); // Only written to
+        radixSortMSD(a, aux.data(), n, static_cast<int>(sizeof(U) * 8) - 8, proj);
+        });
+}
+
+// Template function to perform MSD Radix Sort on a range
+template <SortableRange Range, typename Proj = std::identity>
+void radixSortMSD(Range&& range, Proj proj = Proj()) {
+    radixSortMSD(std::ranges::begin(range), std::ranges::end(range), proj);
+}
+
+// Template function to perform Radix Sort with the default digit size
+template <SortableRange Range, typename Proj = std::identity>
+void radixSort(Range&& range, Proj proj = Proj()) {
+    radixSortLSD<11>(range, proj);
+}
@@ -0,0 +1,454 @@
+/*
+    Parallel Sample Sort (In-Place Parallel Super Scalar Samplesort, IPS4o):
+    - A quick sort with many pivots. Splitters are picked from a random sample, and the array
+      is distributed into up to 256 buckets at once. The buckets are sorted recursively.
+    - Classification is branch-free: the splitters are stored as an implicit binary search
+      tree (Eytzinger layout) and an element descends it with b = 2b + less(tree[b], e), with
+      no data-dependent branch. Batches of 8 elements descend together so their comparisons
+      overlap in the pipeline.
+    - If the sample has repeated splitters, elements equal to a splitter go to an equality
+      bucket of their own that needs no further sorting, so many duplicates cost no extra
+      recursion.
+
+    In-place distribution, with p threads over their own stripes of the array:
+    1. Local classification: every thread moves its elements into one buffer block per
+       bucket. Full buffers are written back to the front of the thread's stripe, which is
+       already consumed. Afterwards each stripe holds full blocks of single buckets followed
+       by empty space.
+    2. The bucket sizes give the final, block-aligned bucket boundaries. In each bucket's
+       region the full blocks are moved to the front.
+    3. Block permutation: the threads take unprocessed blocks from the buckets and swap each
+       one into the next free slot of the bucket it belongs to, like cycle-following over
+       blocks. The read and write pointers of each bucket are updated under a lock per bucket.
+    4. Cleanup: the partial blocks left in the thread buffers, and the parts of blocks that
+       cross into the next bucket, are moved to the free ends of their buckets.
+    - The only extra memory is the buffer blocks: O(p * buckets * block) elements,
+      independent of n. A parallel merge sort needs a second copy of the array.
+    - Buckets are sorted recursively as tasks on the thread pool. A bucket large enough to
+      keep several threads busy is distributed in parallel again. Small buckets go to
+      quickSort.
+
+    Time Complexity (p threads):
+    - Best Case: O(n log n / p)
+    - Average Case: O(n log n / p)
+    - Worst Case: O(n log n) - After too many levels the sub-array is handed to quickSort.
+
+    Space Complexity: O(p * buckets * block) - About 1 MB per thread.
+    In-Place: Yes
+    Stable: No
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm> // For std::min, std::max
+#include <atomic>
+#include <cstdint>
+#include <iterator>  // For std::iter_value_t, std::make_move_iterator
+#include <memory>    // For std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility>   // For std::move, std::index_sequence
+
+#include "helper/ThreadPool.cpp"
+#include "helper/SortInterface.cpp"
+#include "quick-sort.cpp" // Used for the sample and for small buckets
+
+// Size of the blocks moved during distribution, in bytes
+constexpr size_t SAMPLE_SORT_BLOCK_BYTES = 2048;
+// Maximum number of buckets per level, not counting equality buckets
+constexpr size_t SAMPLE_SORT_MAX_BUCKETS = 256;
+// Sub-arrays of up to this many blocks are sorted with quickSort
+constexpr size_t SAMPLE_SORT_BASE_BLOCKS = 16;
+// Number of elements that descend the splitter tree together
+constexpr size_t SAMPLE_SORT_BATCH = 8;
+
+// Template class of the splitters of one distribution step and the classifier using them
+template <typename T>
+class SplitterTree {
+private:
+    std::vector<T> tree;      // tree[1..K) in Eytzinger order: the children of b are 2b and 2b + 1
+    std::vector<T> splitters; // The K - 1 splitters in order
+    size_t logBuckets;
+    bool equalityBuckets; // Whether every splitter has a bucket of the elements equal to it
+
+    // Fill the tree with the splitters by an in-order walk
+    void build(size_t node, size_t& next) {
+        if (node >= tree.size()) return;
+        build(2 * node, next);
+        tree[node] = splitters[next++];
+        build(2 * node + 1, next);
+    }
+
+public:
+    SplitterTree(std::vector<T> sorted, size_t logBuckets, bool equalityBuckets)
+        : tree(size_t(1) << logBuckets, sorted[0]), splitters(std::move(sorted)), logBuckets(logBuckets),
+        equalityBuckets(equalityBuckets) {
+        size_t next = 0;
+        build(1, next);
+    }
+
+    // Number of buckets, equality buckets included
+    size_t buckets() const {
+        return tree.size() << (equalityBuckets ? 1 : 0);
+    }
+
+    // Whether a bucket holds only elements equal to a splitter
+    bool isEqualityBucket(size_t bucket) const {
+        return equalityBuckets && bucket % 2 == 1;
+    }
+
+    // Bucket of one element
+    template <typename Less>
+    size_t classify(const T& element, Less& less) const {
+        size_t b = 1;
+        for (size_t level = 0; level < logBuckets; level++) {
+            b = 2 * b + less(tree[b], element);
+        }
+        return finish(b, element, less);
+    }
+
+    // Buckets of SAMPLE_SORT_BATCH consecutive elements, descending the tree side by side
+    template <typename RandomIt, typename Less>
+    void classifyBatch(RandomIt elements, size_t* buckets, Less& less) const {
+        const T* node = tree.data();
+        size_t b[SAMPLE_SORT_BATCH];
+        for (size_t j = 0; j < SAMPLE_SORT_BATCH; j++) b[j] = 1;
+        for (size_t level = 0; level < logBuckets; level++) {
+            descend(node, b, elements, less, std::make_index_sequence<SAMPLE_SORT_BATCH>());
+        }
+        for (size_t j = 0; j < SAMPLE_SORT_BATCH; j++) {
+            buckets[j] = finish(b[j], elements[j], less);
+        }
+    }
+
+private:
+    // One level of the tree for every element of a batch, unrolled so the comparisons of
+    // different elements are independent instructions
+    template <typename RandomIt, typename Less, size_t... J>
+    static void descend(const T* node, size_t* b, RandomIt elements, Less& less, std::index_sequence<J...>) {
+        ((b[J] = 2 * b[J] + less(node[b[J]], elements[J])), ...);
+    }
+
+    // Turn a leaf of the tree into a bucket: the leaf index is the number of splitters less
+    // than the element, and an element equal to the next splitter goes to its equality bucket
+    template <typename Less>
+    size_t finish(size_t leaf, const T& element, Less& less) const {
+        size_t bucket = leaf - tree.size();
+        if (!equalityBuckets) return bucket;
+        return 2 * bucket + (bucket < splitters.size() && !less(element, splitters[bucket]));
+    }
+};
+
+// Template function to pick the splitters of [first, first + n) from a random sample, which is
+// moved to the front of the array
+template <typename RandomIt, typename Less>
+SplitterTree<std::iter_value_t<RandomIt>> sampleSplitters(RandomIt first, size_t n, size_t block, Less& less) {
+    // As many buckets as leave each of them a few blocks, up to the maximum
+    size_t logBuckets = 1;
+    while ((size_t(2) << logBuckets) <= SAMPLE_SORT_MAX_BUCKETS && (size_t(2) << logBuckets) * 2 * block <= n) {
+        logBuckets++;
+    }
+    size_t buckets = size_t(1) << logBuckets;
+
+    // Oversample by 0.2 log2 n per bucket, so the buckets come out of similar size
+    size_t logN = 0;
+    while ((size_t(2) << logN) <= n) logN++;
+    size_t sampleSize = std::min(n, buckets * std::max<size_t>(1, logN / 5));
+
+    // Swap random elements to the front (xorshift, seeded by n so runs are repeatable)
+    uint64_t state = n * 0x9E3779B97F4A7C15ull + 1;
+    for (size_t i = 0; i < sampleSize; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        std::iter_swap(first + i, first + (i + state % (n - i)));
+    }
+    quickSort(first, first + sampleSize, less);
+
+    std::vector<std::iter_value_t<RandomIt>> splitters;
+    splitters.reserve(buckets - 1);
+    bool repeated = false;
+    for (size_t j = 1; j < buckets; j++) {
+        splitters.push_back(first[j * sampleSize / buckets]);
+        if (j > 1 && !less(splitters[j - 2], splitters[j - 1])) repeated = true;
+    }
+    return SplitterTree<std::iter_value_t<RandomIt>>(std::move(splitters), logBuckets, repeated);
+}
+
+// Template function to run task(t) for t in [0, threads), on the pool if there is more than one
+template <typename Task>
+void sampleSortForEachThread(ThreadPool* pool, unsigned threads, Task&& task) {
+    if (pool == nullptr || threads <= 1) {
+        task(0u);
+        return;
+    }
+    ThreadPool::TaskGroup group;
+    for (unsigned t = 1; t < threads; t++) {
+        pool->spawn(group, [&task, t] { task(t); });
+    }
+    task(0u);
+    pool->wait(group);
+}
+
+// Read and write pointers of a bucket during the block permutation, in blocks
+struct SampleSortBucket {
+    std::mutex lock;
+    std::ptrdiff_t write = 0;       // Next slot to fill
+    std::ptrdiff_t read = -1;       // Last unprocessed block; none once read < write
+    std::atomic<int> reading{ 0 };  // Blocks of this bucket being copied out right now
+};
+
+// Template function to distribute [first, first + n) into the buckets of the splitter tree in
+// place, with `threads` threads. Returns the bucket boundaries.
+template <typename RandomIt, typename T, typename Less>
+std::vector<size_t> sampleSortDistribute(RandomIt first, size_t n, const SplitterTree<T>& splitters,
+    ThreadPool* pool, unsigned threads, Less& less) {
+    const size_t block = std::max<size_t>(SAMPLE_SORT_BLOCK_BYTES / sizeof(T), 1);
+    const size_t buckets = splitters.buckets();
+    const size_t blocks = (n + block - 1) / block;
+    const size_t stripeBlocks = (blocks + threads - 1) / threads;
+
+    // Per thread: a buffer block per bucket (bucket b at b * block, filled up to fill[b]), how
+    // many elements of each bucket it classified, and where its full blocks end. The storage is
+    // filled with copies of an element so T needs no default constructor; the element is copied
+    // before the threads start, because thread 0 moves first[0] while the others fill.
+    const T filler = first[0];
+    std::vector<std::vector<T>> buffers(threads);
+    std::vector<std::vector<size_t>> fill(threads, std::vector<size_t>(buckets, 0));
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(buckets, 0));
+    std::vector<size_t> fullEnd(threads, 0);
+
+    // 1. Local classification
+    sampleSortForEachThread(pool, threads, [&](unsigned t) {
+        size_t begin = std::min(n, t * stripeBlocks * block);
+        size_t end = std::min(n, (t + 1) * stripeBlocks * block);
+        buffers[t].assign(buckets * block, filler);
+        T* buffer = buffers[t].data();
+        size_t* filled = fill[t].data();
+        size_t* count = counts[t].data();
+        size_t write = begin;
+
+        // A full buffer is written over elements that were already classified
+        auto put = [&](size_t i, size_t bucket) {
+            if (filled[bucket] == block) {
+                std::move(buffer + bucket * block, buffer + (bucket + 1) * block, first + write);
+                write += block;
+                count[bucket] += block;
+                filled[bucket] = 0;
+            }
+            buffer[bucket * block + filled[bucket]++] = std::move(first[i]);
+        };
+
+        size_t i = begin;
+        size_t ids[SAMPLE_SORT_BATCH];
+        for (; i + SAMPLE_SORT_BATCH <= end; i += SAMPLE_SORT_BATCH) {
+            splitters.classifyBatch(first + i, ids, less);
+            for (size_t j = 0; j < SAMPLE_SORT_BATCH; j++) put(i + j, ids[j]);
+        }
+        for (; i < end; i++) put(i, splitters.classify(first[i], less));
+        for (size_t b = 0; b < buckets; b++) count[b] += filled[b];
+        fullEnd[t] = write;
+        });
+
+    // 2. Bucket boundaries, and the full blocks of every bucket region moved to its front
+    std::vector<size_t> bounds(buckets + 1, 0);
+    for (size_t b = 0; b < buckets; b++) {
+        size_t size = 0;
+        for (unsigned t = 0; t < threads; t++) size += counts[t][b];
+        bounds[b + 1] = bounds[b] + size;
+    }
+    auto regionBegin = [&](size_t b) { return (bounds[b] + block - 1) / block; }; // In blocks
+    auto isFull = [&](size_t k) { return k * block < fullEnd[k / stripeBlocks]; };
+
+    std::unique_ptr<SampleSortBucket[]> pointers(new SampleSortBucket[buckets]);
+    sampleSortForEachThread(pool, threads, [&](unsigned t) {
+        for (size_t b = t; b < buckets; b += threads) {
+            size_t begin = regionBegin(b), end = regionBegin(b + 1);
+            size_t lo = begin, hi = end;
+            while (lo < hi) {
+                if (isFull(lo)) lo++;
+                else if (!isFull(hi - 1)) hi--;
+                else {
+                    std::move(first + (hi - 1) * block, first + hi * block, first + lo * block);
+                    lo++;
+                    hi--;
+                }
+            }
+            pointers[b].write = static_cast<std::ptrdiff_t>(begin);
+            pointers[b].read = static_cast<std::ptrdiff_t>(lo) - 1;
+        }
+        });
+
+    // 3. Block permutation. A block whose slot would cross the end of the array goes to the
+    // overflow buffer instead (only the last block of the last bucket can).
+    std::vector<T> overflow;
+    size_t overflowBucket = buckets;
+    sampleSortForEachThread(pool, threads, [&](unsigned t) {
+        std::vector<T> held[2];
+        for (size_t k = 0; k < buckets; k++) {
+            SampleSortBucket& source = pointers[(t * buckets / threads + k) % buckets];
+            while (true) {
+                std::ptrdiff_t r;
+                {
+                    std::lock_guard<std::mutex> guard(source.lock);
+                    if (source.read < source.write) break; // Every block of this bucket is placed
+                    r = source.read--;
+                    source.reading.fetch_add(1, std::memory_order_relaxed);
+                }
+                held[0].assign(std::make_move_iterator(first + r * block), std::make_move_iterator(first + (r + 1) * block));
+                source.reading.fetch_sub(1, std::memory_order_release);
+
+                // Swap the held block into its bucket until it lands in an empty slot
+                int current = 0;
+                while (true) {
+                    size_t destination = splitters.classify(held[current][0], less);
+                    SampleSortBucket& target = pointers[destination];
+                    std::ptrdiff_t w;
+                    bool full;
+                    {
+                        std::lock_guard<std::mutex> guard(target.lock);
+                        w = target.write++;
+                        full = w <= target.read;
+                    }
+                    RandomIt slot = first + w * block;
+                    if (full) {
+                        held[1 - current].assign(std::make_move_iterator(slot), std::make_move_iterator(slot + block));
+                        std::move(held[current].begin(), held[current].end(), slot);
+                        current = 1 - current;
+                        continue;
+                    }
+                    // The slot was read by some thread; wait until it is copied out
+                    while (target.reading.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+                    if (static_cast<size_t>(w + 1) * block > n) {
+                        overflow = std::move(held[current]);
+                        overflowBucket = destination;
+                    }
+                    else {
+                        std::move(held[current].begin(), held[current].end(), slot);
+                    }
+                    break;
+                }
+            }
+        }
+        });
+
+    // 4. Cleanup. The part of a bucket's last block that crosses into the next bucket (or the
+    // end of the array, for the overflow block) is set aside first, since the next bucket
+    // fills those positions.
+    auto placedBlocks = [&](size_t b) { return static_cast<size_t>(pointers[b].write) - regionBegin(b); };
+    size_t overflowStart = overflowBucket < buckets ? (regionBegin(overflowBucket) + placedBlocks(overflowBucket) - 1) * block : n;
+    std::vector<std::vector<T>> crossing(buckets);
+    sampleSortForEachThread(pool, threads, [&](unsigned t) {
+        for (size_t b = t; b < buckets; b += threads) {
+            size_t blocksEnd = (regionBegin(b) + placedBlocks(b)) * block;
+            for (size_t i = bounds[b + 1]; placedBlocks(b) > 0 && i < blocksEnd; i++) {
+                crossing[b].push_back(std::move(b == overflowBucket && i >= overflowStart ? overflow[i - overflowStart] : first[i]));
+            }
+        }
+        });
+    sampleSortForEachThread(pool, threads, [&](unsigned t) {
+        for (size_t b = t; b < buckets; b += threads) {
+            size_t begin = bounds[b], end = bounds[b + 1];
+            size_t written = placedBlocks(b);
+            size_t blocksBegin = regionBegin(b) * block;
+            size_t blocksEnd = blocksBegin + written * block;
+
+            // Free positions: before the placed blocks and after them, or the whole bucket
+            size_t ranges[2][2] = { { begin, written > 0 ? blocksBegin : end }, { written > 0 ? std::min(blocksEnd, end) : end, end } };
+            size_t range = 0, position = ranges[0][0];
+            auto place = [&](T& element) {
+                while (position == ranges[range][1]) position = ranges[++range][0];
+                first[position++] = std::move(element);
+            };
+
+            // The part of the overflow block inside the bucket goes where the block would be
+            if (b == overflowBucket && end > overflowStart) {
+                std::move(overflow.begin(), overflow.begin() + (end - overflowStart), first + overflowStart);
+            }
+            for (T& element : crossing[b]) place(element);
+            for (unsigned s = 0; s < threads; s++) {
+                for (size_t i = 0; i < fill[s][b]; i++) place(buffers[s][b * block + i]);
+            }
+        }
+        });
+    return bounds;
+}
+
+// Template function to perform Sample Sort on [first, last) with a comparator on elements.
+// `threads` threads distribute this sub-array; levels limits the recursion depth.
+template <typename RandomIt, typename Less>
+void sampleSortBy(RandomIt first, RandomIt last, ThreadPool* pool, unsigned threads, int levels, Less& less) {
+    using T = std::iter_value_t<RandomIt>;
+    const size_t block = std::max<size_t>(SAMPLE_SORT_BLOCK_BYTES / sizeof(T), 1);
+    size_t n = last - first;
+    if (n <= SAMPLE_SORT_BASE_BLOCKS * block || levels == 0) {
+        quickSort(first, last, less);
+        return;
+    }
+    // Every thread should get a few blocks of every bucket
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, n / (SAMPLE_SORT_MAX_BUCKETS * block))));
+
+    SplitterTree<T> splitters = sampleSplitters(first, n, block, less);
+    std::vector<size_t> bounds = sampleSortDistribute(first, n, splitters, pool, threads, less);
+
+    // Sort the buckets: large ones in parallel again, the others as tasks
+    ThreadPool::TaskGroup group;
+    std::vector<size_t> large;
+    for (size_t b = 0; b + 1 < bounds.size(); b++) {
+        size_t size = bounds[b + 1] - bounds[b];
+        if (size < 2 || splitters.isEqualityBucket(b)) continue;
+        RandomIt begin = first + bounds[b], end = first + bounds[b + 1];
+        if (pool == nullptr) {
+            sampleSortBy(begin, end, pool, 1, levels - 1, less);
+        }
+        else if (threads > 1 && size * threads >= 2 * n) {
+            large.push_back(b);
+        }
+        else {
+            pool->spawn(group, [begin, end, pool, levels, &less] { sampleSortBy(begin, end, pool, 1, levels - 1, less); });
+        }
+    }
+    for (size_t b : large) {
+        size_t size = bounds[b + 1] - bounds[b];
+        sampleSortBy(first + bounds[b], first + bounds[b + 1], pool, static_cast<unsigned>(size * threads / n), levels - 1, less);
+    }
+    if (pool != nullptr) pool->wait(group);
+}
+
+// Template function to perform Sample Sort on an existing pool
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void sampleSort(RandomIt first, RandomIt last, ThreadPool& pool, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    // Each level divides the sizes by up to 256, so 8 levels are plenty for even skewed inputs
+    sampleSortBy(first, last, pool.size() > 1 ? &pool : nullptr, pool.size(), 8, less);
+}
+
+// Template function to perform Sample Sort on a range on an existing pool
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void sampleSort(Range&& range, ThreadPool& pool, Compare comp = Compare(), Proj proj = Proj()) {
+    sampleSort(std::ranges::begin(range), std::ranges::end(range), pool, comp, proj);
+}
+
+// Template function to perform Sample Sort on a range with the given number of threads
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void sampleSort(Range&& range, unsigned threads, Compare comp = Compare(), Proj proj = Proj()) {
+    ThreadPool pool(threads);
+    sampleSort(range, pool, comp, proj);
+}
+
+// Template function to perform Sample Sort on all hardware threads
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SortComparator<Compare, RandomIt, Proj>
+void sampleSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    ThreadPool pool(std::thread::hardware_concurrency());
+    sampleSort(first, last, pool, comp, proj);
+}
+
+// Template function to perform Sample Sort on a range on all hardware threads
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SortComparator<Compare, std::ranges::iterator_t<Range>, Proj>
+void sampleSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    sampleSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -0,0 +1,166 @@
+/*
+    Segmented Sort:
+    - Sorts many short, independent segments of one flat buffer, such as millions of per-user
+      event lists. Segment i is [offsets[i], offsets[i + 1]) of the values, so S segments take
+      S + 1 offsets, as in a CSR matrix. The elements never leave the buffer.
+    - Sorting every segment with its own mergeSort call pays the setup of a sort per segment:
+      a buffer allocation, the comparator wrapping, and the dispatch down to the small cases.
+      Here the setup is paid once per chunk of segments.
+    - Each segment gets the kernel of its length:
+      - up to SORT_NETWORK_MAX elements: a sorting network, for integers in ascending or
+        descending order (see sorting-network.cpp),
+      - up to MERGESORT_CUTOFF elements: insertion sort,
+      - longer: block quick sort for integers in ascending or descending order, merge sort
+        otherwise, with a buffer that is allocated once per chunk and reused by all of its
+        segments,
+      - from SEGMENTED_SORT_PARALLEL_MIN elements on: parallel merge sort on the whole pool.
+    - The segments are cut into chunks of about the same number of elements, several per
+      thread, so that long and short segments balance out. The chunks run as tasks on the
+      work-stealing pool.
+
+    Time Complexity (p threads, segments of length m):
+    - Best Case: O(n log m / p)
+    - Average Case: O(n log m / p)
+    - Worst Case: O(n log m / p)
+
+    Space Complexity: O(p * m) - One merge buffer per running chunk.
+    In-Place: Yes
+    Stable: Yes - Networks and quick sort only take integers, whose order of equal keys cannot
+     be observed.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>  // For std::max
+#include <concepts>   // For std::integral
+#include <functional> // For std::less, std::identity
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>    // For std::cmp_less
+
+#include "insertion-sort.cpp"      // Used for short segments
+#include "sorting-network.cpp"     // Used for short segments of integers
+#include "merge-sort.cpp"          // Used for long segments
+#include "quick-sort.cpp"          // Used for long segments of integers
+#include "parallel-merge-sort.cpp" // Used for very long segments
+#include "helper/ThreadPool.cpp"
+#include "helper/SortInterface.cpp"
+
+// Segments of at least this size are sorted by the whole pool, one at a time
+constexpr size_t SEGMENTED_SORT_PARALLEL_MIN = 1 << 16;
+// Number of chunks per thread, so that threads that finish early can steal the rest
+constexpr size_t SEGMENTED_SORT_CHUNKS_PER_THREAD = 8;
+
+// Template function to sort one segment with the kernel of its length
+template <typename RandomIt, typename T, typename Less>
+void sortSegmentBy(RandomIt first, RandomIt last, std::vector<T>& buffer, Less& less) {
+    std::ptrdiff_t size = last - first;
+    if (size < 2) return;
+    if (static_cast<size_t>(size) <= SORT_NETWORK_MAX && sortSmall(first, last, less)) return;
+    if (size <= MERGESORT_CUTOFF) {
+        insertionSortBy(first, last, less);
+    }
+    else if constexpr (std::is_integral_v<T> && (isNaturalOrder<Less> || isReverseOrder<Less>)) {
+        // Plain integers have no order of equal keys to keep, and block partitioning beats
+        // merging them. Floats do: -0.0 and 0.0 compare equal.
+        int badAllowed = 0;
+        for (auto n = size; n > 1; n >>= 1) {
+            badAllowed++;
+        }
+        blockIntroSort(first, last, badAllowed, true, less);
+    }
+    else {
+        mergeSortBy(first, last, buffer, less);
+    }
+}
+
+// Template function to sort the segments [from, to) that are shorter than
+// SEGMENTED_SORT_PARALLEL_MIN, sharing one merge buffer
+template <typename RandomIt, typename Offsets, typename Less>
+void sortSegmentRange(RandomIt values, const Offsets& offsets, size_t from, size_t to, Less& less) {
+    std::vector<std::iter_value_t<RandomIt>> buffer;
+    for (size_t s = from; s < to; s++) {
+        size_t begin = static_cast<size_t>(offsets[s]), end = static_cast<size_t>(offsets[s + 1]);
+        if (end - begin < SEGMENTED_SORT_PARALLEL_MIN) {
+            sortSegmentBy(values + begin, values + end, buffer, less);
+        }
+    }
+}
+
+// Template function to perform Segmented Sort on an existing pool: values[offsets[i],
+// offsets[i + 1]) is sorted for every i
+template <std::random_access_iterator RandomIt, std::ranges::random_access_range Offsets,
+    typename Compare = std::less<>, typename Proj = std::identity>
+    requires std::integral<std::ranges::range_value_t<Offsets>>
+void segmentedSort(RandomIt first, RandomIt last, const Offsets& offsets, ThreadPool& pool,
+    Compare comp = Compare(), Proj proj = Proj()) {
+    size_t count = static_cast<size_t>(std::ranges::size(offsets));
+    if (count < 2) return;
+    auto offset = std::ranges::begin(offsets);
+    for (size_t s = 0; s + 1 < count; s++) {
+        if (std::cmp_less(offset[s], 0) || offset[s] > offset[s + 1]) {
+            throw std::invalid_argument("Offsets must be non-negative and non-decreasing");
+        }
+    }
+    size_t total = static_cast<size_t>(offset[count - 1] - offset[0]);
+    if (static_cast<size_t>(offset[count - 1]) > static_cast<size_t>(last - first)) {
+        throw std::invalid_argument("Offsets must not go past the end of the values");
+    }
+    auto less = projectedLess(comp, proj);
+
+    // Cut the segments into chunks of about `target` elements, one task each
+    size_t chunks = pool.size() > 1 ? pool.size() * SEGMENTED_SORT_CHUNKS_PER_THREAD : 1;
+    size_t target = std::max<size_t>(total / chunks, 1);
+    ThreadPool::TaskGroup group;
+    for (size_t from = 0; from + 1 < count;) {
+        size_t to = from, elements = 0;
+        while (to + 1 < count && elements < target) {
+            elements += static_cast<size_t>(offset[to + 1] - offset[to]);
+            to++;
+        }
+        if (pool.size() > 1) {
+            pool.spawn(group, [first, offset, from, to, &less] { sortSegmentRange(first, offset, from, to, less); });
+        }
+        else {
+            sortSegmentRange(first, offset, from, to, less);
+        }
+        from = to;
+    }
+    pool.wait(group);
+
+    // Very long segments, skipped by the chunks, get the whole pool one after the other
+    for (size_t s = 0; s + 1 < count; s++) {
+        size_t begin = static_cast<size_t>(offset[s]), end = static_cast<size_t>(offset[s + 1]);
+        if (end - begin >= SEGMENTED_SORT_PARALLEL_MIN) {
+            parallelMergeSort(first + begin, first + end, pool, comp, proj);
+        }
+    }
+}
+
+// Template function to perform Segmented Sort on a range on an existing pool
+template <SortableRange Range, std::ranges::random_access_range Offsets,
+    typename Compare = std::less<>, typename Proj = std::identity>
+void segmentedSort(Range&& values, const Offsets& offsets, ThreadPool& pool, Compare comp = Compare(), Proj proj = Proj()) {
+    segmentedSort(std::ranges::begin(values), std::ranges::end(values), offsets, pool, comp, proj);
+}
+
+// Template function to perform Segmented Sort on a range with the given number of threads
+template <SortableRange Range, std::ranges::random_access_range Offsets,
+    typename Compare = std::less<>, typename Proj = std::identity>
+void segmentedSort(Range&& values, const Offsets& offsets, unsigned threads, Compare comp = Compare(), Proj proj = Proj()) {
+    ThreadPool pool(threads);
+    segmentedSort(values, offsets, pool, comp, proj);
+}
+
+// Template function to perform Segmented Sort on a range on all hardware threads
+template <SortableRange Range, std::ranges::random_access_range Offsets,
+    typename Compare = std::less<>, typename Proj = std::identity>
+    requires SortComparator<Compare, std::ranges::iterator_t<Range>, Proj>
+void segmentedSort(Range&& values, const Offsets& offsets, Compare comp = Compare(), Proj proj = Proj()) {
+    segmentedSort(values, offsets, std::thread::hardware_concurrency(), comp, proj);
+}
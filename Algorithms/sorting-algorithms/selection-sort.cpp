@@ -12,24 +12,34 @@
     Stable: No
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <algorithm> // For std::iter_swap
+
+#include "helper/SortInterface.cpp"
 
 // Template function to perform Selection Sort
-template <typename T>
-void selectionSort(std::vector<T>& arr) {
-    // Get the size of the array
-    int n = arr.size();
-    for (int i = 0;i < n - 1;i++) {
-        // Variable to store the minimum element
-        int minIndex = i;
-        for (int j = i + 1; j < n; j++) {
-            if (arr[j] < arr[minIndex]) {
-                // Update the minimum element index
-                minIndex = j;
+template <std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    auto less = projectedLess(comp, proj);
+    for (RandomIt i = first; last - i > 1; ++i) {
+        // Iterator to the minimum element
+        RandomIt minIt = i;
+        for (RandomIt j = i + 1; j != last; ++j) {
+            if (less(*j, *minIt)) {
+                // Update the minimum element
+                minIt = j;
             }
         }
         // Swap the minimum with the current element
-        std::swap(arr[i], arr[minIndex]);
+        std::iter_swap(i, minIt);
     }
-}
\ No newline at end of file
+}
+
+// Template function to perform Selection Sort on a range
+template <SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void selectionSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    selectionSort(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
@@ -5,19 +5,140 @@
      then progressively reducing the gap between elements to be compared.
     - The final pass of Shell Sort is a regular Insertion Sort.
 
+    Gap sequences are plugged in at compile time through the first template parameter:
+    - CiuraGaps: 1, 4, 10, 23, 57, 132, 301, 701, 1750, then * 2.25 (the default)
+    - TokudaGaps: ceil((9^k - 4^k) / (5 * 4^(k-1))) = 1, 4, 9, 20, 46, 103, ...
+    - SedgewickGaps: 1, then 4^k + 3 * 2^(k-1) + 1 = 8, 23, 77, 281, ...
+    - PrattGaps: all 2^p * 3^q = 1, 2, 3, 4, 6, 8, 9, 12, ...
+    A gap sequence is any type with a static gaps(n) returning the gaps below n in
+    increasing order, starting with 1.
+
+    Every h-sorting pass is unrolled by four: when h >= 4, four consecutive elements belong
+    to four different h-chains, so their insertions are independent and overlap in the CPU.
+
     Time Complexity:
     - Best Case: O(n log n) - When the array is already sorted.
-    - Average Case: ? - Depends on the gap sequence used.
-    - Worst Case: O(n^2) - When the gap sequence is 1.
+    - Average Case: ? - Depends on the gap sequence used (around O(n^1.25) for Ciura/Tokuda).
+    - Worst Case: O(n^(4/3)) for Sedgewick, O(n log^2 n) for Pratt.
 
-    Space Complexity: O(1)
+    Space Complexity: O(1) - Apart from the O(log n) list of gaps.
     In-Place: Yes
     Stable: No
 */
 
+#pragma once
+
 #include <iostream>
 #include <vector>
+#include <algorithm> // For std::min
+#include <utility>   // For std::move
+
+#include "helper/SortInterface.cpp"
+
+// Ciura's experimentally tuned gaps, extended geometrically by 2.25
+struct CiuraGaps {
+    static std::vector<size_t> gaps(size_t n) {
+        std::vector<size_t> result;
+        for (size_t h : { 1, 4, 10, 23, 57, 132, 301, 701, 1750 }) {
+            if (h >= n && h > 1) return result;
+            result.push_back(h);
+        }
+        for (size_t h = 1750 * 9 / 4; h < n; h = h * 9 / 4) {
+            result.push_back(h);
+        }
+        return result;
+    }
+};
+
+// Tokuda's gaps: h(k) = ceil((9^k - 4^k) / (5 * 4^(k-1))), i.e. h(k) = ceil(2.25 h(k-1) + 1)
+struct TokudaGaps {
+    static std::vector<size_t> gaps(size_t n) {
+        std::vector<size_t> result = { 1 };
+        for (double h = 1; ; ) {
+            h = 2.25 * h + 1;
+            size_t gap = static_cast<size_t>(h);
+            if (gap < h) gap++; // Round up
+            if (gap >= n) return result;
+            result.push_back(gap);
+        }
+    }
+};
+
+// Sedgewick's gaps: 1, then 4^k + 3 * 2^(k-1) + 1
+struct SedgewickGaps {
+    static std::vector<size_t> gaps(size_t n) {
+        std::vector<size_t> result = { 1 };
+        for (size_t k = 1; ; k++) {
+            size_t gap = (size_t(1) << (2 * k)) + 3 * (size_t(1) << (k - 1)) + 1;
+            if (gap >= n) return result;
+            result.push_back(gap);
+        }
+    }
+};
+
+// Pratt's gaps: every 3-smooth number 2^p * 3^q
+struct PrattGaps {
+    static std::vector<size_t> gaps(size_t n) {
+        std::vector<size_t> result = { 1 };
+        // Merge the multiples of 2 and 3 of the gaps found so far, in increasing order
+        size_t i2 = 0, i3 = 0;
+        while (true) {
+            size_t gap = std::min(result[i2] * 2, result[i3] * 3);
+            if (gap >= n) return result;
+            result.push_back(gap);
+            if (gap == result[i2] * 2) i2++;
+            if (gap == result[i3] * 3) i3++;
+        }
+    }
+};
+
+// Template function to insert arr[i] into its already h-sorted chain arr[i - h], arr[i - 2h], ...
+template <typename RandomIt, typename Less>
+inline void shellInsert(RandomIt arr, size_t i, size_t h, Less& less) {
+    auto key = std::move(arr[i]);
+    size_t j = i;
+    // Move the larger elements of the chain h places to the right
+    while (j >= h && less(key, arr[j - h])) {
+        arr[j] = std::move(arr[j - h]);
+        j -= h;
+    }
+    arr[j] = std::move(key);
+}
+
+// Template function to h-sort arr[0..n)
+template <typename RandomIt, typename Less>
+void hSort(RandomIt arr, size_t n, size_t h, Less& less) {
+    size_t i = h;
+    // Four consecutive elements lie on four different chains, so these insertions are independent
+    if (h >= 4) {
+        for (; i + 3 < n; i += 4) {
+            shellInsert(arr, i, h, less);
+            shellInsert(arr, i + 1, h, less);
+            shellInsert(arr, i + 2, h, less);
+            shellInsert(arr, i + 3, h, less);
+        }
+    }
+    for (; i < n; i++) {
+        shellInsert(arr, i, h, less);
+    }
+}
+
+// Template function to perform Shell Sort with the gap sequence Gaps
+template <typename Gaps = CiuraGaps, std::random_access_iterator RandomIt, typename Compare = std::less<>, typename Proj = std::identity>
+void shellSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    size_t n = last - first;
+    if (n < 2) return;
+    auto less = projectedLess(comp, proj);
+
+    // h-sort with decreasing gaps, ending with a regular insertion sort (h = 1)
+    std::vector<size_t> gaps = Gaps::gaps(n);
+    for (size_t k = gaps.size(); k-- > 0;) {
+        hSort(first, n, gaps[k], less);
+    }
+}
 
-// Template function to perform Shell Sort
-template <typename T>
-void shellSort(std::vector<T>& arr) { /* Left Unimplemented */ }
\ No newline at end of file
+// Template function to perform Shell Sort on a range with the gap sequence Gaps
+template <typename Gaps = CiuraGaps, SortableRange Range, typename Compare = std::less<>, typename Proj = std::identity>
+void shellSort(Range&& range, Compare comp = Compare(), Proj proj = Proj()) {
+    shellSort<Gaps>(std::ranges::begin(range), std::ranges::end(range), comp, proj);
+}
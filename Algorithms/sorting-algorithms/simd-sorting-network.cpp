@@ -0,0 +1,368 @@
+/*
+    SIMD Sorting Networks:
+    - A sorting network is a fixed sequence of compare-exchange operations that sorts any input.
+     It has no data-dependent branches, so it never mispredicts, and every stage is a vector
+     min/max that handles a whole register of keys at once.
+    - Blocks of 8, 16 or 32 keys are loaded into registers. Each register is sorted on its own
+     with an in-register bitonic network (lane shuffles + min/max + blend), then the sorted
+     registers are combined pairwise with a vectorized bitonic merge. Floats are sorted as
+     integer keys of the same order, so every input value comes back, -0.0 and 0.0 included.
+    - Supported keys are 32-bit integers, floats and 64-bit integers. AVX2 handles all three,
+     SSE4.1 handles 32-bit integers and floats. Smaller inputs are padded with the largest value.
+    - The instruction set is picked at runtime with CPUID, so the same binary still runs on x86
+     hosts without AVX2. The networks are built with GCC and Clang on x86; with other compilers
+     or on other architectures, simdSortSmall always declines.
+
+    simdSortSmall(data, n) sorts n <= 32 keys and returns true, or returns false when the type,
+    size or CPU is not supported and the caller has to use its scalar path.
+
+    Time Complexity:
+    - Best Case: O(n log^2 n) - The network always runs all of its stages.
+    - Average Case: O(n log^2 n)
+    - Worst Case: O(n log^2 n)
+
+    Space Complexity: O(1)
+    In-Place: Yes
+    Stable: No - Unobservable for integers. For floats, -0.0 comes before 0.0 whatever their
+     input order. NaNs are not supported.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>     // For std::memcpy
+#include <limits>
+#include <type_traits>
+
+// GCC and Clang (which also defines __GNUC__) on x86
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+// Largest block handled by the networks
+constexpr size_t SIMD_SORT_MAX = 32;
+
+#ifdef SIMD_SORT_X86
+
+// Instruction sets the networks can use, from worst to best
+enum class SimdLevel { None, SSE41, AVX2 };
+
+// Function to detect the best instruction set of the running CPU (once)
+inline SimdLevel simdLevel() {
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+        return SimdLevel::None;
+        }();
+    return level;
+}
+
+// Function to compute the blend mask selecting the lanes that take the max when every
+// lane i is compare-exchanged with lane i ^ m (the lane with the higher index keeps the max)
+constexpr int maxLaneMask(int lanes, int m) {
+    int top = 1;
+    while (top * 2 <= m) top *= 2;
+    int mask = 0;
+    for (int i = 0; i < lanes; i++) {
+        if (i & top) mask |= 1 << i;
+    }
+    return mask;
+}
+
+// Function to compute an immediate that shuffles 4 lanes so that lane i reads lane i ^ m
+constexpr int xorShuffle4(int m) {
+    return (0 ^ m) | ((1 ^ m) << 2) | ((2 ^ m) << 4) | ((3 ^ m) << 6);
+}
+
+// Function to widen a lane mask so that every bit covers two lanes of half the width
+constexpr int widenMask(int mask) {
+    int wide = 0;
+    for (int i = 0; i < 8; i++) {
+        if (mask & (1 << i)) wide |= 3 << (2 * i);
+    }
+    return wide;
+}
+
+// Vector operations used by the networks, one struct per instruction set and key type.
+// Their member functions are compiled for that instruction set: GCC takes a target pragma
+// around them, Clang an attribute applied to every function in the block.
+// Each provides load/store, an in-place lane permutation i -> i ^ M, a lane-wise min/max
+// and a blend. Registers are only passed by reference: a vector passed by value between
+// functions compiled for different instruction sets does not follow the same ABI.
+
+#ifdef __clang__
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+struct Avx2Int32 {
+    using Key = int32_t;
+    using Reg = __m256i;
+    static constexpr int LANES = 8;
+    static void load(Reg& v, const Key* p) { v = _mm256_loadu_si256(reinterpret_cast<const Reg*>(p)); }
+    static void store(Key* p, const Reg& v) { _mm256_storeu_si256(reinterpret_cast<Reg*>(p), v); }
+    template <int M>
+    static void permuteXor(Reg& v) {
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ M, 1 ^ M, 2 ^ M, 3 ^ M, 4 ^ M, 5 ^ M, 6 ^ M, 7 ^ M));
+    }
+    static void minMax(Reg& a, Reg& b) {
+        Reg lo = _mm256_min_epi32(a, b);
+        b = _mm256_max_epi32(a, b);
+        a = lo;
+    }
+    template <int MASK>
+    static void blend(Reg& a, const Reg& b) { a = _mm256_blend_epi32(a, b, MASK); }
+};
+
+// Floats are sorted as 32-bit integer keys of the same order: the bits of a positive float
+// already grow with it, and flipping all but the sign bit of a negative one makes them grow
+// too. The mapping is applied on load and undone on store. MINPS/MAXPS would instead return
+// one of the operands when they compare equal and turn -0.0 and 0.0 into two copies of the
+// same zero; as keys, -0.0 sorts before 0.0 and both are kept.
+struct Avx2Float : Avx2Int32 {
+    using Key = float;
+    static void flip(Reg& v) { v = _mm256_xor_si256(v, _mm256_srli_epi32(_mm256_srai_epi32(v, 31), 1)); }
+    static void load(Reg& v, const Key* p) { v = _mm256_loadu_si256(reinterpret_cast<const Reg*>(p)); flip(v); }
+    static void store(Key* p, const Reg& v) {
+        Reg bits = v;
+        flip(bits);
+        _mm256_storeu_si256(reinterpret_cast<Reg*>(p), bits);
+    }
+};
+
+struct Avx2Int64 {
+    using Key = int64_t;
+    using Reg = __m256i;
+    static constexpr int LANES = 4;
+    static void load(Reg& v, const Key* p) { v = _mm256_loadu_si256(reinterpret_cast<const Reg*>(p)); }
+    static void store(Key* p, const Reg& v) { _mm256_storeu_si256(reinterpret_cast<Reg*>(p), v); }
+    template <int M>
+    static void permuteXor(Reg& v) {
+        constexpr int IMM = xorShuffle4(M);
+        v = _mm256_permute4x64_epi64(v, IMM);
+    }
+    // AVX2 has no 64-bit min/max, so compare and blend
+    static void minMax(Reg& a, Reg& b) {
+        Reg greater = _mm256_cmpgt_epi64(a, b);
+        Reg lo = _mm256_blendv_epi8(a, b, greater);
+        b = _mm256_blendv_epi8(b, a, greater);
+        a = lo;
+    }
+    template <int MASK>
+    static void blend(Reg& a, const Reg& b) {
+        constexpr int IMM = widenMask(MASK);
+        a = _mm256_blend_epi32(a, b, IMM);
+    }
+};
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#ifdef __clang__
+#pragma clang attribute push (__attribute__((target("sse4.1"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+struct Sse41Int32 {
+    using Key = int32_t;
+    using Reg = __m128i;
+    static constexpr int LANES = 4;
+    static void load(Reg& v, const Key* p) { v = _mm_loadu_si128(reinterpret_cast<const Reg*>(p)); }
+    static void store(Key* p, const Reg& v) { _mm_storeu_si128(reinterpret_cast<Reg*>(p), v); }
+    template <int M>
+    static void permuteXor(Reg& v) {
+        constexpr int IMM = xorShuffle4(M);
+        v = _mm_shuffle_epi32(v, IMM);
+    }
+    static void minMax(Reg& a, Reg& b) {
+        Reg lo = _mm_min_epi32(a, b);
+        b = _mm_max_epi32(a, b);
+        a = lo;
+    }
+    template <int MASK>
+    static void blend(Reg& a, const Reg& b) {
+        constexpr int IMM = widenMask(MASK);
+        a = _mm_blend_epi16(a, b, IMM);
+    }
+};
+
+// Floats as 32-bit integer keys, as for AVX2
+struct Sse41Float : Sse41Int32 {
+    using Key = float;
+    static void flip(Reg& v) { v = _mm_xor_si128(v, _mm_srli_epi32(_mm_srai_epi32(v, 31), 1)); }
+    static void load(Reg& v, const Key* p) { v = _mm_loadu_si128(reinterpret_cast<const Reg*>(p)); flip(v); }
+    static void store(Key* p, const Reg& v) {
+        Reg bits = v;
+        flip(bits);
+        _mm_storeu_si128(reinterpret_cast<Reg*>(p), bits);
+    }
+};
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+// The network templates below are written once for all instruction sets. They are inlined
+// (flattened) into the per-instruction-set entry points, which carry the target attribute.
+// -Wpsabi fires on the register copies inside these templates and is silenced for them.
+#pragma GCC diagnostic push
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wunknown-warning-option"
+#endif
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// Template function to compare-exchange every lane i with lane i ^ M of the same register
+template <typename V, int M>
+inline void exchangeLanes(typename V::Reg& v) {
+    typename V::Reg partner = v;
+    V::template permuteXor<M>(partner);
+    V::minMax(v, partner);
+    // The lane with the higher index of every pair keeps the max
+    V::template blend<maxLaneMask(V::LANES, M)>(v, partner);
+}
+
+// Template function to run the half-cleaners at lane distances D, D/2, ..., 1
+template <typename V, int D>
+inline void cleanLanes(typename V::Reg& v) {
+    if constexpr (D >= 1) {
+        exchangeLanes<V, D>(v);
+        cleanLanes<V, D / 2>(v);
+    }
+}
+
+// Template function to sort the lanes of one register with a bitonic network.
+// Stage S merges sorted runs of S/2 lanes: a flip (lane i against lane i ^ (S-1)) followed by
+// half-cleaners, which keeps every compare-exchange in ascending direction.
+template <typename V, int S = 2>
+inline void sortLanes(typename V::Reg& v) {
+    if constexpr (S <= V::LANES) {
+        exchangeLanes<V, S - 1>(v);
+        cleanLanes<V, S / 4>(v);
+        sortLanes<V, S * 2>(v);
+    }
+}
+
+// Template function to perform the vectorized bitonic merge: r[0..R) holds sorted runs of W
+// registers each, and every pair of neighbouring runs is merged into one sorted run
+template <typename V, int R, int W>
+inline void mergeRegisters(typename V::Reg (&r)[R]) {
+    constexpr int REVERSE = V::LANES - 1; // Lane permutation i -> LANES - 1 - i
+
+    for (int g = 0; g < R; g += 2 * W) {
+        // Flip: element p of the pair of runs against element (2 W LANES - 1 - p)
+        for (int i = 0; i < W; i++) {
+            typename V::Reg& a = r[g + i];
+            typename V::Reg& b = r[g + 2 * W - 1 - i];
+            V::template permuteXor<REVERSE>(b);
+            V::minMax(a, b);
+            V::template permuteXor<REVERSE>(b);
+        }
+        // Half-cleaners across registers
+        for (int d = W / 2; d >= 1; d /= 2) {
+            for (int j = 0; j < 2 * W; j++) {
+                if (!(j & d)) V::minMax(r[g + j], r[g + j + d]);
+            }
+        }
+        // Half-cleaners inside every register
+        for (int j = 0; j < 2 * W; j++) {
+            cleanLanes<V, V::LANES / 2>(r[g + j]);
+        }
+    }
+    if constexpr (2 * W < R) {
+        mergeRegisters<V, R, 2 * W>(r);
+    }
+}
+
+// Template function to sort a block of R registers worth of keys
+template <typename V, int R>
+inline void sortBlock(typename V::Key* data) {
+    typename V::Reg r[R];
+    for (int i = 0; i < R; i++) {
+        V::load(r[i], data + i * V::LANES);
+        sortLanes<V>(r[i]);
+    }
+    if constexpr (R > 1) {
+        mergeRegisters<V, R, 1>(r);
+    }
+    for (int i = 0; i < R; i++) {
+        V::store(data + i * V::LANES, r[i]);
+    }
+}
+
+// Template function to sort n <= 32 keys: pad them to the next block size with the largest
+// key, sort the block and copy the first n keys back
+template <typename V>
+inline void sortPadded(typename V::Key* data, size_t n) {
+    using Key = typename V::Key;
+    Key block[SIMD_SORT_MAX];
+    std::memcpy(block, data, n * sizeof(Key));
+    size_t size = n <= 8 ? 8 : n <= 16 ? 16 : 32;
+    for (size_t i = n; i < size; i++) {
+        block[i] = std::numeric_limits<Key>::has_infinity
+            ? std::numeric_limits<Key>::infinity()
+            : std::numeric_limits<Key>::max();
+    }
+
+    // Blocks of 8, 16 or 32 keys, expressed in registers
+    if (size == 8) sortBlock<V, 8 / V::LANES>(block);
+    else if (size == 16) sortBlock<V, 16 / V::LANES>(block);
+    else sortBlock<V, 32 / V::LANES>(block);
+
+    std::memcpy(data, block, n * sizeof(Key));
+}
+
+#pragma GCC diagnostic pop
+
+// Entry points compiled for each instruction set
+__attribute__((target("avx2"), flatten)) inline void simdSortAvx2(int32_t* data, size_t n) { sortPadded<Avx2Int32>(data, n); }
+__attribute__((target("avx2"), flatten)) inline void simdSortAvx2(float* data, size_t n) { sortPadded<Avx2Float>(data, n); }
+__attribute__((target("avx2"), flatten)) inline void simdSortAvx2(int64_t* data, size_t n) { sortPadded<Avx2Int64>(data, n); }
+__attribute__((target("sse4.1"), flatten)) inline void simdSortSse41(int32_t* data, size_t n) { sortPadded<Sse41Int32>(data, n); }
+__attribute__((target("sse4.1"), flatten)) inline void simdSortSse41(float* data, size_t n) { sortPadded<Sse41Float>(data, n); }
+
+#endif // SIMD_SORT_X86
+
+// Template function to sort data[0..n) with a SIMD sorting network.
+// Returns false (leaving data untouched) if T, n or the CPU is not supported.
+template <typename T>
+bool simdSortSmall(T* data, size_t n) {
+#ifdef SIMD_SORT_X86
+    if (n < 2 || n > SIMD_SORT_MAX) return false;
+
+    // Map T onto the key types of the networks (int and long are the same as int32_t/int64_t)
+    constexpr bool isInt32 = std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4;
+    constexpr bool isInt64 = std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 8;
+    constexpr bool isFloat = std::is_same_v<T, float>;
+
+    SimdLevel level = simdLevel();
+    if constexpr (isInt32 || isFloat) {
+        using Key = std::conditional_t<isFloat, float, int32_t>;
+        Key* keys = reinterpret_cast<Key*>(data);
+        if (level == SimdLevel::AVX2) simdSortAvx2(keys, n);
+        else if (level == SimdLevel::SSE41) simdSortSse41(keys, n);
+        else return false;
+        return true;
+    }
+    else if constexpr (isInt64) {
+        if (level != SimdLevel::AVX2) return false;
+        simdSortAvx2(reinterpret_cast<int64_t*>(data), n);
+        return true;
+    }
+#endif
+    (void)data;
+    (void)n;
+    return false;
+}
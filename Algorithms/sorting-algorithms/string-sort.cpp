@@ -0,0 +1,257 @@
+/*
+    String Sort:
+    - A sort specialized for strings in lexicographic order: multikey quicksort (3-way radix
+      quicksort) on cached characters, with MSD radix bucketing of large groups.
+    - Comparison sorts compare whole strings, so every comparison scans the prefix the two
+      strings share again from the first byte ("Buenos Aires, ..." against "Buenos Aires, ...").
+      String Sort partitions on one position at a time instead: once a group of strings is
+      known to share its first d bytes, those bytes are never looked at again.
+    - Every string gets an entry with a pointer to its characters, its length, its index and a
+      cache of its next 8 characters, big-endian so that the caches compare like the strings.
+      Partitioning compares the caches, a single integer comparison that does not touch the
+      strings, and goes 8 characters deeper only for the group equal to the pivot, whose caches
+      are then reloaded.
+    - Groups of at least STRING_SORT_RADIX_MIN entries are first distributed into 256 buckets on
+      their next character with a counting pass (the burst step of burst sort / MSD radix sort),
+      which costs one pass instead of log n partitions. Small groups are insertion sorted.
+    - Strings that end inside the cache are told apart from those continuing with '\0'
+      characters by their lengths.
+    - The elements are moved once at the end, following the sorted entries (applyPermutation),
+      so elements with a string projection (&Term::query) are sorted by it without being moved
+      during the sort.
+    - Works on std::string, std::string_view, and any element whose projection returns
+      something convertible to std::string_view. The order is that of std::string: bytes
+      compared as unsigned char.
+
+    Time Complexity: O(n log n + D) - Where D is the total length of the distinguishing prefixes.
+    Space Complexity: O(n) - One entry and one index per string.
+    In-Place: No
+    Stable: No
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>  // For std::iter_swap
+#include <concepts>   // For std::convertible_to
+#include <cstdint>    // For uint64_t
+#include <cstring>    // For std::memcpy, std::memcmp
+#include <functional> // For std::invoke, std::identity
+#include <iterator>
+#include <type_traits>
+
+#include "insertion-sort.cpp"  // Sorts small groups
+#include "indirect-sort.cpp"   // applyPermutation moves the elements
+#include "helper/SortInterface.cpp"
+
+// Groups up to this size are insertion sorted
+constexpr size_t STRING_SORT_INSERTION_MAX = 16;
+// Groups from this size on are distributed into buckets on their next character
+constexpr size_t STRING_SORT_RADIX_MIN = 4096;
+
+// Entry of one string: where its characters are and its next 8 characters
+struct StringSortEntry {
+    uint64_t cache;             // Characters [depth, depth + 8), big-endian, padded with zeros
+    const unsigned char* chars;
+    size_t length;
+    size_t index;               // Position of the element in the input
+};
+
+// Function to load the 8 characters at depth of a string, big-endian and padded with zeros
+inline uint64_t loadStringCache(const unsigned char* chars, size_t length, size_t depth) {
+    unsigned char bytes[8] = {};
+    if (depth < length) std::memcpy(bytes, chars + depth, std::min<size_t>(8, length - depth));
+    uint64_t cache = 0;
+    for (unsigned char byte : bytes) cache = (cache << 8) | byte;
+    return cache;
+}
+
+// Function to compare two entries whose strings are equal up to depth: negative, zero or positive
+inline int compareStringEntries(const StringSortEntry& a, const StringSortEntry& b, size_t depth) {
+    if (a.cache != b.cache) return a.cache < b.cache ? -1 : 1;
+    // Equal caches: a string that ends inside them is a prefix of the other
+    if (a.length > depth + 8 && b.length > depth + 8) {
+        size_t common = std::min(a.length, b.length) - (depth + 8);
+        int order = std::memcmp(a.chars + depth + 8, b.chars + depth + 8, common);
+        if (order != 0) return order;
+    }
+    return a.length < b.length ? -1 : a.length > b.length ? 1 : 0;
+}
+
+// Function to insertion sort entries that are equal up to depth
+inline void insertionSortStrings(StringSortEntry* entries, size_t n, size_t depth) {
+    for (size_t i = 1; i < n; i++) {
+        StringSortEntry entry = entries[i];
+        size_t j = i;
+        for (; j > 0 && compareStringEntries(entry, entries[j - 1], depth) < 0; j--) {
+            entries[j] = entries[j - 1];
+        }
+        entries[j] = entry;
+    }
+}
+
+inline void multikeyQuickSort(StringSortEntry* entries, size_t n, size_t depth, std::vector<StringSortEntry>& scratch);
+
+// Function to split entries with equal caches at depth: the strings ending inside the cache are
+// moved to the front and ordered by length, the caches of the others are reloaded 8 characters
+// deeper. Returns where the others start.
+inline StringSortEntry* splitEndedStrings(StringSortEntry* entries, size_t n, size_t depth) {
+    StringSortEntry* rest = std::partition(entries, entries + n,
+        [depth](const StringSortEntry& e) { return e.length <= depth + 8; });
+    size_t endedCount = static_cast<size_t>(rest - entries);
+    if (endedCount > 1) {
+        // Usually all of the same length, which insertion sort checks in one pass
+        insertionSortStrings(entries, endedCount, depth);
+    }
+    for (StringSortEntry* e = rest; e != entries + n; e++) {
+        e->cache = loadStringCache(e->chars, e->length, depth + 8);
+    }
+    return rest;
+}
+
+// Function to sort entries with equal caches at depth
+inline void sortEqualCaches(StringSortEntry* entries, size_t n, size_t depth, std::vector<StringSortEntry>& scratch) {
+    StringSortEntry* rest = splitEndedStrings(entries, n, depth);
+    multikeyQuickSort(rest, static_cast<size_t>(entries + n - rest), depth + 8, scratch);
+}
+
+// Function to distribute entries equal up to depth into 256 buckets on the character at
+// depth + shift / 8 (shift counts the cache bits already bucketed), then sort every bucket
+inline void radixBucketStrings(StringSortEntry* entries, size_t n, size_t depth, unsigned shift,
+    std::vector<StringSortEntry>& scratch) {
+    size_t count[256] = {};
+    unsigned bitsBelow = 56 - shift;
+    for (size_t i = 0; i < n; i++) count[(entries[i].cache >> bitsBelow) & 0xFF]++;
+
+    // Exclusive prefix sums give where each bucket starts
+    size_t start[257];
+    start[0] = 0;
+    for (size_t c = 0; c < 256; c++) start[c + 1] = start[c] + count[c];
+
+    if (scratch.size() < n) scratch.resize(n);
+    size_t next[256];
+    std::copy(start, start + 256, next);
+    for (size_t i = 0; i < n; i++) scratch[next[(entries[i].cache >> bitsBelow) & 0xFF]++] = entries[i];
+    std::copy(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(n), entries);
+
+    for (size_t c = 0; c < 256; c++) {
+        StringSortEntry* bucket = entries + start[c];
+        size_t size = count[c];
+        if (size < 2) continue;
+        if (shift == 56) {
+            // All 8 cached characters are equal
+            sortEqualCaches(bucket, size, depth, scratch);
+        }
+        else if (size >= STRING_SORT_RADIX_MIN) {
+            radixBucketStrings(bucket, size, depth, shift + 8, scratch);
+        }
+        else {
+            multikeyQuickSort(bucket, size, depth, scratch);
+        }
+    }
+}
+
+// Function to sort entries whose strings are equal up to depth and whose caches hold the
+// characters at depth. Recurses into the two smaller parts of each partition and loops on
+// the largest one, so a long prefix shared by many strings does not deepen the recursion.
+inline void multikeyQuickSort(StringSortEntry* entries, size_t n, size_t depth, std::vector<StringSortEntry>& scratch) {
+    while (n > STRING_SORT_INSERTION_MAX) {
+        bool allEqual = true;
+        for (size_t i = 1; i < n && allEqual; i++) allEqual = entries[i].cache == entries[0].cache;
+        if (allEqual) {
+            StringSortEntry* rest = splitEndedStrings(entries, n, depth);
+            n -= static_cast<size_t>(rest - entries);
+            entries = rest;
+            depth += 8;
+            continue;
+        }
+        if (n >= STRING_SORT_RADIX_MIN) {
+            radixBucketStrings(entries, n, depth, 0, scratch);
+            return;
+        }
+
+        // Median of 3 caches, or the ninther for larger groups, as in Quick Sort
+        auto median3 = [entries](size_t a, size_t b, size_t c) {
+            uint64_t x = entries[a].cache, y = entries[b].cache, z = entries[c].cache;
+            return x < y ? (y < z ? b : x < z ? c : a) : (x < z ? a : y < z ? c : b);
+        };
+        size_t mid = n / 2;
+        size_t pivotIndex;
+        if (n > 40) {
+            size_t step = n / 8;
+            pivotIndex = median3(median3(0, step, 2 * step), median3(mid - step, mid, mid + step),
+                median3(n - 1 - 2 * step, n - 1 - step, n - 1));
+        }
+        else {
+            pivotIndex = median3(0, mid, n - 1);
+        }
+        uint64_t pivot = entries[pivotIndex].cache;
+
+        // 3-way partition on the caches: [0, lt) smaller, [lt, gt) equal, [gt, n) greater
+        size_t lt = 0, i = 0, gt = n;
+        while (i < gt) {
+            uint64_t cache = entries[i].cache;
+            if (cache < pivot) std::swap(entries[lt++], entries[i++]);
+            else if (cache > pivot) std::swap(entries[i], entries[--gt]);
+            else i++;
+        }
+
+        size_t smaller = lt, equal = gt - lt, greater = n - gt;
+        if (smaller >= equal && smaller >= greater) {
+            sortEqualCaches(entries + lt, equal, depth, scratch);
+            multikeyQuickSort(entries + gt, greater, depth, scratch);
+            n = smaller;
+        }
+        else if (greater >= equal) {
+            multikeyQuickSort(entries, smaller, depth, scratch);
+            sortEqualCaches(entries + lt, equal, depth, scratch);
+            entries += gt;
+            n = greater;
+        }
+        else {
+            multikeyQuickSort(entries, smaller, depth, scratch);
+            multikeyQuickSort(entries + gt, greater, depth, scratch);
+            StringSortEntry* rest = splitEndedStrings(entries + lt, equal, depth);
+            n = static_cast<size_t>(entries + gt - rest);
+            entries = rest;
+            depth += 8;
+        }
+    }
+    insertionSortStrings(entries, n, depth);
+}
+
+// Template function to perform String Sort: sort [first, last) by the strings proj returns
+template <std::random_access_iterator RandomIt, typename Proj = std::identity>
+    requires std::convertible_to<std::invoke_result_t<Proj&, std::iter_reference_t<RandomIt>>, std::string_view>
+void stringSort(RandomIt first, RandomIt last, Proj proj = Proj()) {
+    size_t n = static_cast<size_t>(last - first);
+    using Key = std::invoke_result_t<Proj&, std::iter_reference_t<RandomIt>>;
+    static_assert(std::is_lvalue_reference_v<Key> || !std::is_same_v<std::remove_cvref_t<Key>, std::string>,
+        "The projection must not return strings by value: the entries point into them");
+    if (n < 2) return;
+
+    std::vector<StringSortEntry> entries(n);
+    for (size_t i = 0; i < n; i++) {
+        std::string_view key = std::invoke(proj, first[i]);
+        const unsigned char* chars = reinterpret_cast<const unsigned char*>(key.data());
+        entries[i] = { loadStringCache(chars, key.size(), 0), chars, key.size(), i };
+    }
+
+    std::vector<StringSortEntry> scratch;
+    multikeyQuickSort(entries.data(), n, 0, scratch);
+
+    std::vector<size_t> perm(n);
+    for (size_t i = 0; i < n; i++) perm[i] = entries[i].index;
+    entries = {};
+    applyPermutation(first, last, std::move(perm));
+}
+
+// Template function to perform String Sort on a range
+template <SortableRange Range, typename Proj = std::identity>
+    requires std::convertible_to<std::invoke_result_t<Proj&, std::ranges::range_reference_t<Range>>, std::string_view>
+void stringSort(Range&& range, Proj proj = Proj()) {
+    stringSort(std::ranges::begin(range), std::ranges::end(range), proj);
+}
@@ -51,6 +51,10 @@
 #include <iostream>
 // Include the <stdexcept> header to use std::runtime_error
 #include <stdexcept>
+// Include the <functional> header to use std::less
+#include <functional>
+// Merge sort of linked nodes, used by sort()
+#include "../../Algorithms/sorting-algorithms/list-merge-sort.cpp"
 
 // Deque class template
 template <typename dataType>
@@ -202,6 +206,16 @@ public:
         return item;
     }
 
+    // Sort the items from front to back by relinking the nodes, without copying any item
+    template <typename Comparator = std::less<>>
+    void sort(Comparator comp = Comparator()) {
+        // Sort the nodes through their next pointers; the previous pointers and the tail are
+        // rebuilt along the way
+        head = listMergeSort(head, &Node::next, [&comp](const Node* a, const Node* b) {
+            return comp(a->data, b->data);
+            }, &Node::prev, &tail);
+    }
+
     // Unit testing
     static void unit_test() {
         // Create a deque of integers
@@ -243,6 +257,18 @@ public:
             std::cout << "Caught exception: " << e.what() << std::endl;
         }
 
+        // Test sort()
+        deque.push_back(3); // 3
+        deque.push_back(1); // 3 1
+        deque.push_front(2); // 2 3 1
+        deque.sort(); // 1 2 3
+        std::cout << "Pop front after sort: " << deque.pop_front() << std::endl; // 2 3
+        std::cout << "Pop back after sort: " << deque.pop_back() << std::endl; // 2
+        deque.push_back(5); // 2 5
+        deque.sort(std::greater<>()); // 5 2
+        std::cout << "Pop front after sort: " << deque.pop_front() << std::endl; // 2
+        std::cout << "Pop back after sort: " << deque.pop_back() << std::endl; // empty
+
         /*
             Expected output:
                 Is empty? Yes
@@ -255,6 +281,10 @@ public:
                 Pop back: 30
                 Is empty? Yes
                 Caught exception: Deque is empty
+                Pop front after sort: 1
+                Pop back after sort: 3
+                Pop front after sort: 5
+                Pop back after sort: 2
         */
     }
 };
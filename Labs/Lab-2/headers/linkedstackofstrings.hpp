@@ -2,6 +2,9 @@
 
 #include <iostream>
 #include <string>
+#include <functional>
+
+#include "../../../Algorithms/sorting-algorithms/list-merge-sort.cpp"
 
 using std::string;
 
@@ -46,5 +49,13 @@ public:
         return first == nullptr;
     }
 
+    // Sort the items from top to bottom by relinking the nodes, without copying any string
+    template <typename Comparator = std::less<>>
+    void sort(Comparator comp = Comparator()) {
+        first = listMergeSort(first, &Node::next, [&comp](const Node* a, const Node* b) {
+            return comp(a->item, b->item);
+            });
+    }
+
 };
 
@@ -6,6 +6,9 @@
 #include <numeric>   // For accumulate
 #include <iomanip>   // For formatting the output
 
+// SIMD sorting networks for the small subarrays
+#include "../../Algorithms/sorting-algorithms/simd-sorting-network.cpp"
+
 const int CUTOFF = 10;  // cutoff for switching to insertion sort
 
 // Insertion sort for small subarrays
@@ -76,9 +79,11 @@ void optimizedSort(std::vector<int>& a, std::vector<int>& aux, int lo, int hi) {
     // Base case: if the subarray has 0 or 1 elements, it is already sorted
     if (hi <= lo) return;
 
-    // 1. Cutoff to insertion sort for small subarrays
+    // 1. Cutoff to a sorting network (or insertion sort if the CPU has none) for small subarrays
     if (hi <= lo + CUTOFF) {
-        insertionSort(a, lo, hi);
+        if (!simdSortSmall(&a[lo], hi - lo + 1)) {
+            insertionSort(a, lo, hi);
+        }
         return;
     }
 